@@ -0,0 +1,59 @@
+API_VERSION = '-1.0'
+AR = ['/usr/bin/ar']
+ARFLAGS = ['rcs']
+BINDIR = '/usr/local/bin'
+CC_VERSION = ('12', '2', '0')
+COMPILER_CXX = 'g++'
+CPPPATH_ST = '-I%s'
+CXX = ['/usr/bin/g++']
+CXXFLAGS = ['-Wall', '-Wextra', '-D_FILE_OFFSET_BITS=64', '-D__STDC_FORMAT_MACROS', '-std=c++11', '-DBOOST_NO_CXX11_SCOPED_ENUMS', '-DLIBSUB_VERSION="devel"', '-DLIBSUB_POSIX', '-O3', '-Wno-deprecated-declarations', '-DBOOST_TEST_DYN_LINK']
+CXXFLAGS_MACBUNDLE = ['-fPIC']
+CXXFLAGS_cxxshlib = ['-fPIC']
+CXXLNK_SRC_F = []
+CXXLNK_TGT_F = ['-o']
+CXX_NAME = 'gcc'
+CXX_SRC_F = []
+CXX_TGT_F = ['-c', '-o']
+DEFINES = ['HAVE_OPENSSL=1']
+DEFINES_ST = '-D%s'
+DEFINE_COMMENTS = {'HAVE_OPENSSL': ''}
+DEST_BINFMT = 'elf'
+DEST_CPU = 'x86_64'
+DEST_OS = 'linux'
+DISABLE_TESTS = False
+ENABLE_DEBUG = False
+HAVE_BOOST_SYSTEM = True
+HAVE_OPENSSL = 1
+LIBDIR = '/usr/local/lib64'
+LIBPATH_BOOST_FILESYSTEM = ['/usr/local/lib']
+LIBPATH_BOOST_LOCALE = ['/usr/local/lib']
+LIBPATH_BOOST_REGEX = ['/usr/local/lib']
+LIBPATH_ST = '-L%s'
+LIB_BOOST_FILESYSTEM = ['boost_system', 'boost_filesystem']
+LIB_BOOST_LOCALE = ['boost_system', 'boost_locale', 'icuio', 'icui18n', 'icuuc', 'icudata', 'icui18n', 'icuuc', 'icudata', 'icuuc', 'icudata']
+LIB_BOOST_REGEX = ['boost_system', 'boost_regex']
+LIB_BOOST_SYSTEM = ['boost_system']
+LIB_BOOST_TEST = ['boost_unit_test_framework']
+LIB_OPENSSL = ['ssl', 'crypto']
+LIB_ST = '-l%s'
+LINKFLAGS = ['-Lsrc', '-pthread']
+LINKFLAGS_MACBUNDLE = ['-bundle', '-undefined', 'dynamic_lookup']
+LINKFLAGS_cxxshlib = ['-shared']
+LINKFLAGS_cxxstlib = ['-Wl,-Bstatic']
+LINK_CXX = ['/usr/bin/g++']
+PKGCONFIG = ['/usr/bin/pkg-config']
+PREFIX = '/usr/local'
+RPATH_ST = '-Wl,-rpath,%s'
+SHLIB_MARKER = '-Wl,-Bdynamic'
+SONAME_ST = '-Wl,-h,%s'
+STATIC = False
+STLIBPATH_ST = '-L%s'
+STLIB_MARKER = '-Wl,-Bstatic'
+STLIB_ST = '-l%s'
+TARGET_WINDOWS_32 = False
+TARGET_WINDOWS_64 = False
+cxxprogram_PATTERN = '%s'
+cxxshlib_PATTERN = 'lib%s.so'
+cxxstlib_PATTERN = 'lib%s.a'
+define_key = ['HAVE_OPENSSL']
+macbundle_PATTERN = '%s.bundle'
@@ -0,0 +1,2 @@
+version = 0x2001800
+tools = [{'tool': 'ar', 'tooldir': None, 'funs': None}, {'tool': 'cxx', 'tooldir': None, 'funs': None}, {'tool': 'g++', 'tooldir': None, 'funs': None}, {'tool': 'compiler_cxx', 'tooldir': None, 'funs': None}, {'tool': 'clang_compilation_database', 'tooldir': ['waf-tools'], 'funs': None}]
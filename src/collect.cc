@@ -0,0 +1,80 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/collect.cc
+ *  @brief Helpers for collect().
+ */
+
+#include "collect.h"
+#include <algorithm>
+#include <numeric>
+
+using std::vector;
+
+/** @return indices which put keys into ascending order, with equal keys left in the order that they were given */
+vector<size_t>
+sub::stable_order (vector<int64_t> const& keys)
+{
+	auto const N = keys.size();
+	vector<size_t> order (N);
+	std::iota (order.begin(), order.end(), 0);
+
+	if (N < 256) {
+		std::stable_sort (order.begin(), order.end(), [&keys](size_t a, size_t b) { return keys[a] < keys[b]; });
+		return order;
+	}
+
+	/* LSD radix sort, a byte at a time, of the keys with their sign bits flipped so that
+	   they sort correctly as unsigned values.
+	*/
+	int const passes = sizeof(uint64_t);
+	vector<uint64_t> unsigned_keys (N);
+	vector<size_t> counts (passes * 256);
+	for (size_t i = 0; i < N; ++i) {
+		auto const k = static_cast<uint64_t>(keys[i]) ^ (uint64_t(1) << 63);
+		unsigned_keys[i] = k;
+		for (int pass = 0; pass < passes; ++pass) {
+			++counts[pass * 256 + ((k >> (pass * 8)) & 0xff)];
+		}
+	}
+
+	vector<size_t> next (N);
+	for (int pass = 0; pass < passes; ++pass) {
+		auto count = counts.begin() + pass * 256;
+		auto const shift = pass * 8;
+		if (count[(unsigned_keys[0] >> shift) & 0xff] == N) {
+			/* Every key has the same value of this byte */
+			continue;
+		}
+
+		size_t offset = 0;
+		for (int i = 0; i < 256; ++i) {
+			auto const c = count[i];
+			count[i] = offset;
+			offset += c;
+		}
+
+		for (auto i: order) {
+			next[count[(unsigned_keys[i] >> shift) & 0xff]++] = i;
+		}
+		order.swap (next);
+	}
+
+	return order;
+}
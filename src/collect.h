@@ -22,43 +22,126 @@
 
 #include "subtitle.h"
 #include "raw_subtitle.h"
+#include "raw_subtitle_track.h"
 #include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <utility>
 
 namespace sub {
 
+std::vector<size_t> stable_order (std::vector<int64_t> const& keys);
+
 /** Collect sub::RawSubtitle objects into sub::Subtitles.
  *  This method is templated so that any container type can be used for the result.
+ *  Passing an rvalue avoids copying raw; its text is then moved into the result.
  */
 template <class T>
 T
 collect (std::vector<RawSubtitle> raw)
 {
-	std::stable_sort (raw.begin(), raw.end());
+	/* Input from most readers is already in order, so only sort if we must */
+	std::vector<int64_t> keys;
+	keys.reserve (raw.size());
+	for (auto const& i: raw) {
+		keys.push_back (i.from.ticks());
+	}
+
+	if (!std::is_sorted(keys.begin(), keys.end())) {
+		std::vector<RawSubtitle> sorted;
+		sorted.reserve (raw.size());
+		for (auto i: stable_order(keys)) {
+			sorted.push_back (std::move(raw[i]));
+		}
+		raw.swap (sorted);
+	}
 
 	T out;
 
 	boost::optional<Subtitle> current;
-	for (auto const& i: raw) {
+	for (auto& i: raw) {
 		if (current && current->same_metadata(i)) {
 			/* This RawSubtitle can be added to current... */
 			if (!current->lines.empty() && current->lines.back().same_metadata(i)) {
 				/* ... and indeed to its last line */
-				current->lines.back().blocks.push_back(Block(i));
+				current->lines.back().blocks.emplace_back(std::move(i));
 			} else {
 				/* ... as a new line */
-				current->lines.push_back(Line(i));
+				current->lines.emplace_back(std::move(i));
 			}
 		} else {
 			/* We must start a new Subtitle */
 			if (current) {
-				out.push_back (current.get ());
+				out.push_back (std::move(current.get()));
+			}
+			current.emplace (std::move(i));
+		}
+	}
+
+	if (current) {
+		out.push_back (std::move(current.get()));
+	}
+
+	return out;
+}
+
+/** Collect the fragments of a RawSubtitleTrack into sub::Subtitles, in the same way as
+ *  collect(std::vector<RawSubtitle>) but without making a RawSubtitle for each fragment.
+ */
+template <class T>
+T
+collect (RawSubtitleTrack const& track)
+{
+	/* Sort the fragments' indices rather than the fragments themselves */
+	std::vector<int64_t> keys;
+	keys.reserve (track.size());
+	for (size_t i = 0; i < track.size(); ++i) {
+		keys.push_back (track.from(i).ticks());
+	}
+
+	std::vector<size_t> order;
+	if (std::is_sorted(keys.begin(), keys.end())) {
+		order.resize (track.size());
+		std::iota (order.begin(), order.end(), 0);
+	} else {
+		order = stable_order (keys);
+	}
+
+	T out;
+
+	boost::optional<Subtitle> current;
+	for (auto i: order) {
+		Block block;
+		block.text = track.text (i);
+		track.style(i).apply (block);
+
+		auto const vertical = track.vertical_position (i);
+
+		if (current && current->from == track.from(i) && current->to == track.to(i) && current->fade_up == track.fade_up(i) && current->fade_down == track.fade_down(i)) {
+			if (!current->lines.empty() && current->lines.back().vertical_position == vertical) {
+				current->lines.back().blocks.push_back (std::move(block));
+				continue;
+			}
+		} else {
+			if (current) {
+				out.push_back (std::move(current.get()));
 			}
-			current = Subtitle (i);
+			current = Subtitle ();
+			current->from = track.from (i);
+			current->to = track.to (i);
+			current->fade_up = track.fade_up (i);
+			current->fade_down = track.fade_down (i);
 		}
+
+		Line line;
+		line.horizontal_position = track.horizontal_position (i);
+		line.vertical_position = vertical;
+		line.blocks.push_back (std::move(block));
+		current->lines.push_back (std::move(line));
 	}
 
 	if (current) {
-		out.push_back (current.get ());
+		out.push_back (std::move(current.get()));
 	}
 
 	return out;
@@ -0,0 +1,132 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/diagnostic.cc
+ *  @brief Diagnostic class and sinks that readers can report diagnostics to.
+ */
+
+#include "compose.hpp"
+#include "diagnostic.h"
+
+using std::string;
+using std::vector;
+using namespace sub;
+
+string
+sub::diagnostic_code_name (DiagnosticCode code)
+{
+	switch (code) {
+	case DiagnosticCode::UNRECOGNISED_LINE:
+		return "unrecognised-line";
+	case DiagnosticCode::UNRECOGNISED_TIME:
+		return "unrecognised-time";
+	case DiagnosticCode::BAD_CUE:
+		return "bad-cue";
+	case DiagnosticCode::SUPPRESSED:
+		return "suppressed";
+	}
+
+	return "";
+}
+
+std::ostream&
+sub::operator<< (std::ostream& s, Diagnostic const& d)
+{
+	switch (d.severity) {
+	case DiagnosticSeverity::INFO:
+		s << "info";
+		break;
+	case DiagnosticSeverity::WARNING:
+		s << "warning";
+		break;
+	case DiagnosticSeverity::ERROR:
+		s << "error";
+		break;
+	}
+
+	if (d.line) {
+		s << ": line " << *d.line;
+	}
+
+	s << ": " << d.message << " [" << diagnostic_code_name(d.code) << "]";
+	return s;
+}
+
+void
+CollectingDiagnosticSink::report (Diagnostic const& diagnostic)
+{
+	std::lock_guard<std::mutex> lm (_mutex);
+	_diagnostics.push_back (diagnostic);
+}
+
+vector<Diagnostic>
+CollectingDiagnosticSink::diagnostics () const
+{
+	std::lock_guard<std::mutex> lm (_mutex);
+	return _diagnostics;
+}
+
+void
+StreamDiagnosticSink::report (Diagnostic const& diagnostic)
+{
+	std::lock_guard<std::mutex> lm (_mutex);
+	_stream << diagnostic << "\n";
+}
+
+LimitingDiagnosticSink::LimitingDiagnosticSink (std::shared_ptr<DiagnosticSink> next, int limit)
+	: _next (next)
+	, _limit (limit)
+{
+
+}
+
+void
+LimitingDiagnosticSink::report (Diagnostic const& diagnostic)
+{
+	{
+		std::lock_guard<std::mutex> lm (_mutex);
+		if (++_seen[diagnostic.code] > _limit) {
+			return;
+		}
+	}
+
+	_next->report (diagnostic);
+}
+
+void
+LimitingDiagnosticSink::flush ()
+{
+	std::map<DiagnosticCode, int> seen;
+	{
+		std::lock_guard<std::mutex> lm (_mutex);
+		std::swap (seen, _seen);
+	}
+
+	for (auto const& i: seen) {
+		if (i.second > _limit) {
+			_next->report (
+				Diagnostic(
+					DiagnosticSeverity::INFO,
+					DiagnosticCode::SUPPRESSED,
+					String::compose("%1 more %2 diagnostics were suppressed", i.second - _limit, diagnostic_code_name(i.first))
+					)
+				);
+		}
+	}
+}
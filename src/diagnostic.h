@@ -0,0 +1,161 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/diagnostic.h
+ *  @brief Diagnostic class and sinks that readers can report diagnostics to.
+ */
+
+#ifndef LIBSUB_DIAGNOSTIC_H
+#define LIBSUB_DIAGNOSTIC_H
+
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace sub {
+
+enum class DiagnosticSeverity
+{
+	INFO,
+	WARNING,
+	ERROR
+};
+
+/** Kinds of problem that a reader can report */
+enum class DiagnosticCode
+{
+	/** a line which could not be understood, and was ignored */
+	UNRECOGNISED_LINE,
+	/** a timestamp which could not be parsed */
+	UNRECOGNISED_TIME,
+	/** a cue which could not be read, and was skipped */
+	BAD_CUE,
+	/** some diagnostics were not passed on by a LimitingDiagnosticSink */
+	SUPPRESSED
+};
+
+extern std::string diagnostic_code_name (DiagnosticCode code);
+
+/** @class Diagnostic
+ *  @brief A problem that was found in some input, which did not stop it being read.
+ */
+class Diagnostic
+{
+public:
+	Diagnostic () {}
+
+	Diagnostic (DiagnosticSeverity s, DiagnosticCode c, std::string m, boost::optional<int> l = boost::none, boost::optional<int64_t> o = boost::none)
+		: severity (s)
+		, code (c)
+		, message (m)
+		, line (l)
+		, offset (o)
+	{}
+
+	DiagnosticSeverity severity = DiagnosticSeverity::WARNING;
+	DiagnosticCode code = DiagnosticCode::UNRECOGNISED_LINE;
+	std::string message;
+	/** line number in the input, starting from 1, if known */
+	boost::optional<int> line;
+	/** offset in bytes from the start of the input to the start of the line given by `line', if known */
+	boost::optional<int64_t> offset;
+};
+
+std::ostream& operator<< (std::ostream& s, Diagnostic const& d);
+
+/** @class DiagnosticSink
+ *  @brief Parent for classes which receive diagnostics from readers.
+ *
+ *  One sink may be given to several readers, which may be running on different threads,
+ *  so implementations must be thread-safe.
+ */
+class DiagnosticSink
+{
+public:
+	virtual ~DiagnosticSink () {}
+
+	virtual void report (Diagnostic const& diagnostic) = 0;
+};
+
+/** @class CollectingDiagnosticSink
+ *  @brief DiagnosticSink which keeps everything that it is given.
+ */
+class CollectingDiagnosticSink : public DiagnosticSink
+{
+public:
+	void report (Diagnostic const& diagnostic) override;
+
+	std::vector<Diagnostic> diagnostics () const;
+
+private:
+	mutable std::mutex _mutex;
+	std::vector<Diagnostic> _diagnostics;
+};
+
+/** @class StreamDiagnosticSink
+ *  @brief DiagnosticSink which writes each diagnostic to a stream as a line of text.
+ */
+class StreamDiagnosticSink : public DiagnosticSink
+{
+public:
+	/** @param stream Stream, which must remain valid for the lifetime of this object */
+	explicit StreamDiagnosticSink (std::ostream& stream)
+		: _stream (stream)
+	{}
+
+	void report (Diagnostic const& diagnostic) override;
+
+private:
+	std::mutex _mutex;
+	std::ostream& _stream;
+};
+
+/** @class LimitingDiagnosticSink
+ *  @brief DiagnosticSink which passes on only the first few diagnostics with each code.
+ *
+ *  This stops a badly-broken file with a problem on every line from flooding a log.
+ *  flush() reports how many diagnostics of each code were held back.
+ */
+class LimitingDiagnosticSink : public DiagnosticSink
+{
+public:
+	/** @param next Sink to pass diagnostics on to.
+	 *  @param limit Maximum number of diagnostics to pass on for each code.
+	 */
+	LimitingDiagnosticSink (std::shared_ptr<DiagnosticSink> next, int limit);
+
+	void report (Diagnostic const& diagnostic) override;
+	void flush ();
+
+private:
+	std::mutex _mutex;
+	std::shared_ptr<DiagnosticSink> _next;
+	int _limit;
+	/** number of diagnostics seen so far with each code */
+	std::map<DiagnosticCode, int> _seen;
+};
+
+}
+
+#endif
@@ -0,0 +1,221 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/diff.cc
+ *  @brief diff() method.
+ */
+
+#include "collect.h"
+#include "diff.h"
+#include "hash.h"
+#include "subtitle.h"
+#include <algorithm>
+#include <deque>
+#include <numeric>
+#include <unordered_map>
+
+using std::vector;
+using boost::optional;
+using namespace sub;
+
+/** @return indices of subs in order of from time, and then of to time */
+static vector<size_t>
+time_order (vector<Subtitle> const& subs)
+{
+	auto earlier = [&subs](size_t x, size_t y) {
+		return subs[x].from < subs[y].from || (subs[x].from == subs[y].from && subs[x].to < subs[y].to);
+	};
+
+	vector<size_t> order (subs.size());
+	std::iota (order.begin(), order.end(), 0);
+	if (std::is_sorted(order.begin(), order.end(), earlier)) {
+		return order;
+	}
+
+	vector<int64_t> keys;
+	keys.reserve (subs.size());
+	for (auto const& i: subs) {
+		keys.push_back (i.from.ticks());
+	}
+
+	order = stable_order (keys);
+
+	/* Sort each run with the same from time by to time */
+	for (auto i = order.begin(); i != order.end(); ) {
+		auto j = i + 1;
+		while (j != order.end() && keys[*j] == keys[*i]) {
+			++j;
+		}
+		if (j - i > 1) {
+			std::stable_sort (i, j, earlier);
+		}
+		i = j;
+	}
+
+	return order;
+}
+
+/** @return a hash of what a subtitle contains, ignoring its times */
+static vector<uint64_t>
+content_hashes (vector<Subtitle> const& subs)
+{
+	vector<uint64_t> hashes;
+	hashes.reserve (subs.size());
+	for (auto const& i: subs) {
+		Hasher h;
+		h.add (i.lines);
+		hashes.push_back (h.get());
+	}
+	return hashes;
+}
+
+static bool
+same_times (Subtitle const& a, Subtitle const& b)
+{
+	return a.from == b.from && a.to == b.to && a.fade_up == b.fade_up && a.fade_down == b.fade_down;
+}
+
+/** Find the differences between two versions of a track.
+ *
+ *  Subtitles are paired up in three sweeps over the tracks in time order: first those
+ *  with the same times, then those with the same content, and then those which overlap
+ *  in time.  Whatever is left has been deleted from a or inserted into b.  Each sweep
+ *  is linear in the size of the tracks (as well as a sort if they are not in order).
+ *
+ *  @param a Old version of the track.
+ *  @param b New version of the track.
+ *  @return Changes, in order of time; subtitles which are the same in a and b are not mentioned.
+ */
+vector<Change>
+sub::diff (vector<Subtitle> const& a, vector<Subtitle> const& b)
+{
+	auto const a_order = time_order (a);
+	auto const b_order = time_order (b);
+	auto const a_hashes = content_hashes (a);
+	auto const b_hashes = content_hashes (b);
+
+	vector<optional<size_t>> a_match (a.size());
+	vector<optional<size_t>> b_match (b.size());
+	vector<Change> changes;
+
+	/* Subtitles with the same times */
+	for (size_t i = 0, j = 0; i < a_order.size() && j < b_order.size(); ) {
+		auto const& x = a[a_order[i]];
+		auto const& y = b[b_order[j]];
+		if (x.from < y.from || (x.from == y.from && x.to < y.to)) {
+			++i;
+		} else if (y.from < x.from || (x.from == y.from && y.to < x.to)) {
+			++j;
+		} else {
+			a_match[a_order[i]] = b_order[j];
+			b_match[b_order[j]] = a_order[i];
+			if (a_hashes[a_order[i]] != b_hashes[b_order[j]] || x.lines != y.lines) {
+				changes.push_back (Change(Change::Type::CHANGED, a_order[i], b_order[j], !same_times(x, y)));
+			} else if (!same_times(x, y)) {
+				/* Only the fades are different */
+				changes.push_back (Change(Change::Type::RETIMED, a_order[i], b_order[j]));
+			}
+			++i;
+			++j;
+		}
+	}
+
+	/* Subtitles with the same content in both, taken in order */
+	std::unordered_map<uint64_t, std::deque<size_t>> unmatched;
+	for (auto j: b_order) {
+		if (!b_match[j]) {
+			unmatched[b_hashes[j]].push_back (j);
+		}
+	}
+
+	for (auto i: a_order) {
+		if (a_match[i]) {
+			continue;
+		}
+		auto candidates = unmatched.find (a_hashes[i]);
+		if (candidates == unmatched.end()) {
+			continue;
+		}
+		/* Take the first candidate which really has the same content; the others have a
+		   hash which collides with ours but may still match a later subtitle in a.
+		*/
+		auto& queue = candidates->second;
+		auto const match = std::find_if (queue.begin(), queue.end(), [&a, &b, i](size_t j) { return a[i].lines == b[j].lines; });
+		if (match != queue.end()) {
+			auto const j = *match;
+			queue.erase (match);
+			a_match[i] = j;
+			b_match[j] = i;
+			changes.push_back (Change(Change::Type::RETIMED, i, j));
+		}
+	}
+
+	/* Subtitles which overlap in time */
+	vector<size_t> a_left;
+	for (auto i: a_order) {
+		if (!a_match[i]) {
+			a_left.push_back (i);
+		}
+	}
+	vector<size_t> b_left;
+	for (auto j: b_order) {
+		if (!b_match[j]) {
+			b_left.push_back (j);
+		}
+	}
+
+	for (size_t i = 0, j = 0; i < a_left.size() && j < b_left.size(); ) {
+		auto const& x = a[a_left[i]];
+		auto const& y = b[b_left[j]];
+		if (x.from < y.to && y.from < x.to) {
+			a_match[a_left[i]] = b_left[j];
+			b_match[b_left[j]] = a_left[i];
+			changes.push_back (Change(Change::Type::CHANGED, a_left[i], b_left[j], !same_times(x, y)));
+			++i;
+			++j;
+		} else if (!(y.from < x.to)) {
+			++i;
+		} else {
+			++j;
+		}
+	}
+
+	for (auto i: a_left) {
+		if (!a_match[i]) {
+			changes.push_back (Change(Change::Type::DELETED, i, optional<size_t>()));
+		}
+	}
+
+	for (auto j: b_left) {
+		if (!b_match[j]) {
+			changes.push_back (Change(Change::Type::INSERTED, optional<size_t>(), j));
+		}
+	}
+
+	/* Put the changes in order of time, using the new version's time where there is one */
+	auto time = [&a, &b](Change const& c) {
+		return c.b ? b[*c.b].from : a[*c.a].from;
+	};
+
+	std::stable_sort (changes.begin(), changes.end(), [&time](Change const& x, Change const& y) {
+		return time(x) < time(y);
+	});
+
+	return changes;
+}
@@ -0,0 +1,71 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/diff.h
+ *  @brief Change class and diff() method.
+ */
+
+#ifndef LIBSUB_DIFF_H
+#define LIBSUB_DIFF_H
+
+#include <boost/optional.hpp>
+#include <vector>
+
+namespace sub {
+
+class Subtitle;
+
+/** @class Change
+ *  @brief A difference between two versions of a track.
+ */
+class Change
+{
+public:
+	enum class Type {
+		/** subtitle b is new */
+		INSERTED,
+		/** subtitle a has been removed */
+		DELETED,
+		/** subtitle a has the same content as b but different times */
+		RETIMED,
+		/** subtitle a has become b, with different text or style and possibly different times */
+		CHANGED
+	};
+
+	Change (Type type_, boost::optional<size_t> a_, boost::optional<size_t> b_, bool retimed_ = false)
+		: type (type_)
+		, a (a_)
+		, b (b_)
+		, retimed (retimed_)
+	{}
+
+	Type type;
+	/** index of the subtitle in the old track, if there is one */
+	boost::optional<size_t> a;
+	/** index of the subtitle in the new track, if there is one */
+	boost::optional<size_t> b;
+	/** true if a CHANGED subtitle's times are also different */
+	bool retimed;
+};
+
+std::vector<Change> diff (std::vector<Subtitle> const& a, std::vector<Subtitle> const& b);
+
+}
+
+#endif
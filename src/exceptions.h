@@ -38,6 +38,17 @@ public:
 	{}
 };
 
+/** @class FileError
+ *  @brief An error raised when a file cannot be opened or read.
+ */
+class FileError : public std::runtime_error
+{
+public:
+	FileError (std::string const & message)
+		: std::runtime_error (message)
+	{}
+};
+
 /** @class STLError
  *  @brief An error raised when reading a binary STL file.
  */
@@ -125,6 +136,17 @@ public:
 	{}
 };
 
+/** @class CollectError
+ *  @brief An error raised when subtitles cannot be collected, for example because they are out of order.
+ */
+class CollectError : public std::runtime_error
+{
+public:
+	CollectError (std::string const & message)
+		: std::runtime_error (message)
+	{}
+};
+
 class ProgrammingError : public std::runtime_error
 {
 public:
@@ -0,0 +1,50 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/executor.h
+ *  @brief Executor class.
+ */
+
+#ifndef LIBSUB_EXECUTOR_H
+#define LIBSUB_EXECUTOR_H
+
+#include <functional>
+#include <vector>
+
+namespace sub {
+
+/** @class Executor
+ *  @brief Parent for classes which can run some tasks, perhaps concurrently.
+ *
+ *  Callers can implement this to have libsub use their own threads.
+ */
+class Executor
+{
+public:
+	virtual ~Executor () {}
+
+	/** Run some tasks in any order, returning when all of them have finished.
+	 *  If any task throws, one of the exceptions is rethrown once every task has finished.
+	 */
+	virtual void run (std::vector<std::function<void ()>> tasks) = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,183 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/hash.cc
+ *  @brief Hasher class.
+ */
+
+#include "colour.h"
+#include "font_size.h"
+#include "hash.h"
+#include "horizontal_position.h"
+#include "sub_time.h"
+#include "subtitle.h"
+#include "vertical_position.h"
+#include <cstring>
+
+using std::string;
+using namespace sub;
+
+/** Mix the bits of a 64-bit value (the finaliser from SplitMix64) */
+static inline uint64_t
+mix (uint64_t x)
+{
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+	return x ^ (x >> 31);
+}
+
+void
+Hasher::add (uint64_t v)
+{
+	_state = mix (_state ^ mix(v + 0x9e3779b97f4a7c15));
+}
+
+void
+Hasher::add (float v)
+{
+	if (v == 0) {
+		/* -0 == 0 */
+		v = 0;
+	}
+
+	uint32_t bits;
+	memcpy (&bits, &v, sizeof(bits));
+	add (static_cast<uint64_t>(bits));
+}
+
+void
+Hasher::add (string const& s)
+{
+	add (static_cast<uint64_t>(s.size()));
+
+	/* Take the bytes 8 at a time, in the same order whatever the platform's byte order */
+	auto const data = reinterpret_cast<unsigned char const*>(s.data());
+	size_t i = 0;
+	while (i < s.size()) {
+		uint64_t word = 0;
+		for (size_t j = 0; j < 8 && i < s.size(); ++j, ++i) {
+			word |= static_cast<uint64_t>(data[i]) << (j * 8);
+		}
+		add (word);
+	}
+}
+
+void
+Hasher::add (Time const& t)
+{
+	/* Times are equal if they have the same number of ticks, whatever their rate */
+	add (t.ticks());
+}
+
+void
+Hasher::add (Colour const& c)
+{
+	add (c.r);
+	add (c.g);
+	add (c.b);
+}
+
+void
+Hasher::add (FontSize const& s)
+{
+	add (s.proportional());
+	add (s.points());
+}
+
+void
+Hasher::add (HorizontalPosition const& p)
+{
+	/* proportional is compared with a tolerance, so it cannot be part of the hash */
+	add (static_cast<int>(p.reference));
+}
+
+void
+Hasher::add (VerticalPosition const& p)
+{
+	/* Equal positions always have the same reference, but which of the other fields are
+	   compared depends on which are set.
+	*/
+	boost::optional<int> reference;
+	if (p.reference) {
+		reference = static_cast<int>(*p.reference);
+	}
+	add (reference);
+}
+
+void
+Hasher::add (Block const& b)
+{
+	add (content_hash(b));
+}
+
+void
+Hasher::add (Line const& l)
+{
+	add (content_hash(l));
+}
+
+void
+Hasher::add (Subtitle const& s)
+{
+	add (content_hash(s));
+}
+
+uint64_t
+sub::content_hash (Block const& b)
+{
+	Hasher h;
+	h.add (b.text);
+	h.add (b.font);
+	h.add (b.font_size);
+	boost::optional<int> effect;
+	if (b.effect) {
+		effect = static_cast<int>(*b.effect);
+	}
+	h.add (effect);
+	h.add (b.effect_colour);
+	h.add (b.colour);
+	h.add (b.bold);
+	h.add (b.italic);
+	h.add (b.underline);
+	return h.get ();
+}
+
+/** @return a hash of a Line, made from the content_hash() of each of its blocks */
+uint64_t
+sub::content_hash (Line const& l)
+{
+	Hasher h;
+	h.add (l.horizontal_position);
+	h.add (l.vertical_position);
+	h.add (l.blocks);
+	return h.get ();
+}
+
+/** @return a hash of a Subtitle, made from the content_hash() of each of its lines */
+uint64_t
+sub::content_hash (Subtitle const& s)
+{
+	Hasher h;
+	h.add (s.from);
+	h.add (s.to);
+	h.add (s.fade_up);
+	h.add (s.fade_down);
+	h.add (s.lines);
+	return h.get ();
+}
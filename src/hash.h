@@ -0,0 +1,147 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/hash.h
+ *  @brief Hasher class and hashes of libsub's value types.
+ */
+
+#ifndef LIBSUB_HASH_H
+#define LIBSUB_HASH_H
+
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace sub {
+
+class Block;
+class Colour;
+class FontSize;
+class HorizontalPosition;
+class Line;
+class Subtitle;
+class Time;
+class VerticalPosition;
+
+/** @class Hasher
+ *  @brief Builds a 64-bit hash of some values.
+ *
+ *  The result depends only on the values added and their order, not on the platform or the
+ *  run, so it can be stored and used as a key for content.  Objects which are equal
+ *  according to their operator== give the same hash.  Some of those operators accept
+ *  values which are close but not identical (e.g. HorizontalPosition), so the hash of
+ *  such an object only includes the parts which must be exactly equal.
+ *
+ *  Adding a Subtitle, Line or Block adds its content_hash(), and a Subtitle's or Line's
+ *  content_hash() is made from those of its parts, so the hashes of parts can be kept and
+ *  combined with add(uint64_t) without hashing the parts again.
+ */
+class Hasher
+{
+public:
+	void add (uint64_t v);
+	void add (int64_t v) {
+		add (static_cast<uint64_t>(v));
+	}
+	void add (int v) {
+		add (static_cast<uint64_t>(static_cast<int64_t>(v)));
+	}
+	void add (bool v) {
+		add (static_cast<uint64_t>(v ? 1 : 0));
+	}
+	void add (float v);
+	void add (std::string const& s);
+
+	void add (Time const& t);
+	void add (Colour const& c);
+	void add (FontSize const& s);
+	void add (HorizontalPosition const& p);
+	void add (VerticalPosition const& p);
+	void add (Block const& b);
+	void add (Line const& l);
+	void add (Subtitle const& s);
+
+	template <class T>
+	void add (boost::optional<T> const& v) {
+		add (static_cast<bool>(v));
+		if (v) {
+			add (*v);
+		}
+	}
+
+	template <class T>
+	void add (std::vector<T> const& v) {
+		add (static_cast<uint64_t>(v.size()));
+		for (auto const& i: v) {
+			add (i);
+		}
+	}
+
+	uint64_t get () const {
+		return _state;
+	}
+
+private:
+	uint64_t _state = 0x6a09e667f3bcc908;
+};
+
+/** @return a hash of t, which is the same on all platforms */
+template <class T>
+uint64_t
+content_hash (T const& t)
+{
+	Hasher h;
+	h.add (t);
+	return h.get ();
+}
+
+uint64_t content_hash (Block const& b);
+uint64_t content_hash (Line const& l);
+uint64_t content_hash (Subtitle const& s);
+
+}
+
+/** Make a std::hash for a libsub type from content_hash */
+#define LIBSUB_STD_HASH(T) \
+	template <> \
+	struct hash<T> \
+	{ \
+		size_t operator() (T const& v) const { \
+			return static_cast<size_t>(sub::content_hash(v)); \
+		} \
+	};
+
+namespace std {
+
+LIBSUB_STD_HASH(sub::Time)
+LIBSUB_STD_HASH(sub::Colour)
+LIBSUB_STD_HASH(sub::FontSize)
+LIBSUB_STD_HASH(sub::HorizontalPosition)
+LIBSUB_STD_HASH(sub::VerticalPosition)
+LIBSUB_STD_HASH(sub::Block)
+LIBSUB_STD_HASH(sub::Line)
+LIBSUB_STD_HASH(sub::Subtitle)
+
+}
+
+#undef LIBSUB_STD_HASH
+
+#endif
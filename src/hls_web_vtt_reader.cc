@@ -0,0 +1,177 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/hls_web_vtt_reader.cc
+ *  @brief HLSWebVTTReader class.
+ */
+
+#include "compose.hpp"
+#include "exceptions.h"
+#include "hash.h"
+#include "hls_web_vtt_reader.h"
+#include "line_source.h"
+#include "subtitle.h"
+#include "time_parser.h"
+#include "web_vtt_reader.h"
+#include <boost/algorithm/string.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+
+using std::string;
+using std::vector;
+using namespace sub;
+
+int64_t const HLSWebVTTReader::mpegts_rate;
+int64_t const HLSWebVTTReader::mpegts_wrap;
+
+HLSWebVTTReader::HLSWebVTTReader (int64_t mpegts_origin)
+	: _mpegts_origin (mpegts_origin)
+{
+	_more = false;
+}
+
+HLSWebVTTReader::HLSWebVTTReader (vector<boost::filesystem::path> const& segments, int64_t mpegts_origin)
+	: _mpegts_origin (mpegts_origin)
+{
+	_more = false;
+	for (auto const& i: segments) {
+		add_segment (i);
+	}
+}
+
+/** Parse the value of an X-TIMESTAMP-MAP header, e.g. MPEGTS:900000,LOCAL:00:00:00.000
+ *  @return the amount, in ticks, to add to the segment's cue times.
+ */
+int64_t
+HLSWebVTTReader::parse_timestamp_map (string const& map)
+{
+	boost::optional<int64_t> mpegts;
+	boost::optional<Time> local;
+
+	vector<string> parts;
+	boost::algorithm::split (parts, map, boost::is_any_of(","));
+	for (auto const& i: parts) {
+		auto const colon = i.find(':');
+		if (colon == string::npos) {
+			continue;
+		}
+		auto const key = boost::algorithm::trim_copy(i.substr(0, colon));
+		auto const value = boost::algorithm::trim_copy(i.substr(colon + 1));
+		if (key == "MPEGTS") {
+			char* end;
+			auto const v = strtoll (value.c_str(), &end, 10);
+			if (!value.empty() && *end == '\0' && v >= 0) {
+				mpegts = v;
+			}
+		} else if (key == "LOCAL") {
+			auto const t = parse_time<WebVTTTimeFormat> (value);
+			if (t) {
+				local = t.time;
+			}
+		}
+	}
+
+	if (!mpegts || !local) {
+		throw WebVTTError (String::compose("Badly formatted X-TIMESTAMP-MAP %1", map));
+	}
+
+	/* Time stamps are 33 bits, so they can wrap around during a long stream; take the
+	   value which is closest to the last one that we saw.
+	*/
+	auto value = *mpegts;
+	if (_last_mpegts) {
+		while (value - *_last_mpegts > mpegts_wrap / 2) {
+			value -= mpegts_wrap;
+		}
+		while (*_last_mpegts - value > mpegts_wrap / 2) {
+			value += mpegts_wrap;
+		}
+	}
+	_last_mpegts = value;
+
+	return (value - _mpegts_origin) * (Time::ticks_per_second / mpegts_rate) - local->ticks();
+}
+
+/** Parse a segment and add its cues, apart from any which are repeated from the previous segment */
+void
+HLSWebVTTReader::add_segment (char const* data, size_t size)
+{
+	MemoryLineSource source (data, size);
+	WebVTTReader reader (source, _diagnostic_sink, _error_policy);
+
+	int64_t offset = 0;
+	auto const metadata = reader.metadata ();
+	auto const map = metadata.find ("X-TIMESTAMP-MAP");
+	if (map != metadata.end()) {
+		offset = parse_timestamp_map (map->second);
+	}
+
+	auto subs = reader.subtitles ();
+	std::set<CueKey> cues;
+
+	/* Each cue gives a run of subtitles with the same times; cues with the same times
+	   within a segment are treated as one, which is fine as they will be repeated together.
+	*/
+	for (size_t start = 0; start < subs.size(); ) {
+		size_t end = start + 1;
+		while (end < subs.size() && subs[end].from == subs[start].from && subs[end].to == subs[start].to) {
+			++end;
+		}
+
+		/* A Block made from a fragment has its text and all of its style */
+		Hasher hasher;
+		for (size_t i = start; i < end; ++i) {
+			hasher.add (Block(subs[i]));
+			hasher.add (subs[i].horizontal_position);
+			hasher.add (subs[i].vertical_position);
+		}
+
+		CueKey const key (subs[start].from.ticks() + offset, subs[start].to.ticks() + offset, hasher.get());
+		cues.insert (key);
+
+		if (_previous_cues.find(key) != _previous_cues.end()) {
+			++_repeated_cues;
+		} else {
+			for (size_t i = start; i < end; ++i) {
+				auto& sub = subs[i];
+				sub.from = Time::from_ticks (sub.from.ticks() + offset, sub.from.rate());
+				sub.to = Time::from_ticks (sub.to.ticks() + offset, sub.to.rate());
+				add (sub);
+			}
+		}
+
+		start = end;
+	}
+
+	_previous_cues = std::move (cues);
+}
+
+void
+HLSWebVTTReader::add_segment (string const& segment)
+{
+	add_segment (segment.data(), segment.size());
+}
+
+void
+HLSWebVTTReader::add_segment (boost::filesystem::path file)
+{
+	MappedLineSource source (file);
+	add_segment (source.data(), source.size());
+}
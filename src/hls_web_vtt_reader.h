@@ -0,0 +1,95 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/hls_web_vtt_reader.h
+ *  @brief HLSWebVTTReader class.
+ */
+
+#ifndef LIBSUB_HLS_WEB_VTT_READER_H
+#define LIBSUB_HLS_WEB_VTT_READER_H
+
+#include "reader.h"
+#include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace sub {
+
+/** @class HLSWebVTTReader
+ *  @brief A class to read the WebVTT segments of an HLS subtitle rendition.
+ *
+ *  Segments are given to add_segment() in order, as they arrive, and each is parsed
+ *  straight away.  Cue times in each segment are moved onto the presentation timeline
+ *  using the segment's X-TIMESTAMP-MAP header, if it has one.  A cue which spans the
+ *  boundary between segments is usually repeated in each of them; such repeats (cues
+ *  with the same times and text as one in the previous segment) are dropped, so only
+ *  the keys of one segment's cues need to be kept.
+ *
+ *  Subtitles are available from next() or subtitles() as soon as the segment that
+ *  they are in has been added.
+ */
+class HLSWebVTTReader : public Reader
+{
+public:
+	/** @param mpegts_origin MPEG-TS time, in 90kHz units, which should become time zero
+	 *  (usually the presentation time stamp of the start of the stream).
+	 */
+	explicit HLSWebVTTReader (int64_t mpegts_origin = 0);
+
+	/** Read some segments.
+	 *  @param segments WebVTT segment files, in order.
+	 *  @param mpegts_origin MPEG-TS time, in 90kHz units, which should become time zero.
+	 */
+	explicit HLSWebVTTReader (std::vector<boost::filesystem::path> const& segments, int64_t mpegts_origin = 0);
+
+	void add_segment (char const* data, size_t size);
+	void add_segment (std::string const& segment);
+	void add_segment (boost::filesystem::path file);
+
+	/** @return number of cues which have been dropped as repeats of ones in the previous segment */
+	int repeated_cues () const {
+		return _repeated_cues;
+	}
+
+	/** MPEG-TS time stamps count at this rate */
+	static int64_t const mpegts_rate = 90000;
+	/** MPEG-TS time stamps wrap around at this value */
+	static int64_t const mpegts_wrap = int64_t(1) << 33;
+
+private:
+	int64_t parse_timestamp_map (std::string const& map);
+
+	int64_t _mpegts_origin;
+	/** the last MPEG-TS time stamp that we saw, allowing for wrap-around */
+	boost::optional<int64_t> _last_mpegts;
+
+	/** from, to and content hash of a cue */
+	typedef std::tuple<int64_t, int64_t, uint64_t> CueKey;
+	/** keys of the cues in the last segment that was added */
+	std::set<CueKey> _previous_cues;
+	int _repeated_cues = 0;
+};
+
+}
+
+#endif
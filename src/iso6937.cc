@@ -21,8 +21,9 @@
 #include "iso6937.h"
 #include <boost/optional.hpp>
 #include <boost/locale.hpp>
-#include <string>
 #include <iostream>
+#include <mutex>
+#include <string>
 
 using std::string;
 using std::cout;
@@ -33,12 +34,20 @@ using boost::optional;
 using boost::locale::conv::utf_to_utf;
 using namespace sub;
 
+/** Make the tables the first time they are needed, in a way that is safe if
+ *  several threads need them at once.
+ */
+static void
+ensure_tables ()
+{
+	static std::once_flag once;
+	std::call_once (once, make_iso6937_tables);
+}
+
 wstring
 sub::iso6937_to_utf16 (string s)
 {
-	if (iso6937::diacriticals.empty ()) {
-		make_iso6937_tables ();
-	}
+	ensure_tables ();
 
 	wstring o;
 
@@ -77,9 +86,7 @@ find (map<char, wchar_t> const & m, wchar_t c)
 string
 sub::utf16_to_iso6937 (wstring s)
 {
-	if (iso6937::diacriticals.empty ()) {
-		make_iso6937_tables ();
-	}
+	ensure_tables ();
 
 	/* XXX: slow */
 
@@ -0,0 +1,255 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/line_source.cc
+ *  @brief LineSource class and its implementations.
+ */
+
+#include "compose.hpp"
+#include "exceptions.h"
+#include "line_source.h"
+#include "util.h"
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#ifdef LIBSUB_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using std::string;
+using namespace sub;
+
+int const LineSource::history_lines;
+
+MemoryLineSource::MemoryLineSource (char const* data, size_t size, int first_line_number, int64_t first_offset)
+	: _data (data)
+	, _size (size)
+	, _line_number (first_line_number - 1)
+	, _first_offset (first_offset)
+{
+
+}
+
+MemoryLineSource::MemoryLineSource (string data)
+	: _owned (std::move(data))
+{
+	set_data (_owned.data(), _owned.size());
+}
+
+void
+MemoryLineSource::set_data (char const* data, size_t size)
+{
+	_data = data;
+	_size = size;
+	_position = 0;
+}
+
+bool
+MemoryLineSource::get (SourceLine& line)
+{
+	if (_position >= _size) {
+		return false;
+	}
+
+	auto const start = _data + _position;
+	auto const remaining = _size - _position;
+	auto newline = static_cast<char const*> (memchr(start, '\n', remaining));
+
+	line.data = start;
+	line.length = newline ? (newline - start) : remaining;
+	line.number = ++_line_number;
+	line.offset = _first_offset + _position;
+
+	_position += newline ? (line.length + 1) : remaining;
+	return true;
+}
+
+bool
+MemoryLineSource::recall (int64_t offset, size_t length, string& text) const
+{
+	auto const start = offset - _first_offset;
+	if (start < 0 || static_cast<size_t>(start) + length > _size) {
+		return false;
+	}
+
+	text.assign (_data + start, length);
+	return true;
+}
+
+MappedLineSource::MappedLineSource (boost::filesystem::path file)
+{
+#ifdef LIBSUB_POSIX
+	int const fd = open (file.string().c_str(), O_RDONLY);
+	if (fd == -1) {
+		throw FileError (String::compose("Could not open %1", file.string()));
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) == -1) {
+		close (fd);
+		throw FileError (String::compose("Could not find size of %1", file.string()));
+	}
+
+	_map_size = st.st_size;
+	if (_map_size > 0) {
+		_map = mmap (nullptr, _map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (_map == MAP_FAILED) {
+			_map = nullptr;
+			close (fd);
+			throw FileError (String::compose("Could not map %1", file.string()));
+		}
+		madvise (_map, _map_size, MADV_SEQUENTIAL);
+	}
+
+	close (fd);
+	set_data (static_cast<char const*>(_map), _map_size);
+#else
+	std::ifstream in (file.string().c_str(), std::ios::binary);
+	if (!in.good()) {
+		throw FileError (String::compose("Could not open %1", file.string()));
+	}
+	_fallback.assign (std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	set_data (_fallback.data(), _fallback.size());
+#endif
+}
+
+MappedLineSource::~MappedLineSource ()
+{
+#ifdef LIBSUB_POSIX
+	if (_map) {
+		munmap (_map, _map_size);
+	}
+#endif
+}
+
+FileLineSource::FileLineSource (FILE* file, size_t buffer_size)
+	: _file (file)
+	, _buffer (std::max(buffer_size, size_t(1)))
+{
+
+}
+
+FileLineSource::FileLineSource (FILE* file, string const& prefix, size_t buffer_size)
+	: _file (file)
+	, _buffer (std::max(buffer_size, prefix.size() + 1))
+	, _end (prefix.size())
+{
+	std::copy (prefix.begin(), prefix.end(), _buffer.begin());
+}
+
+bool
+FileLineSource::get (SourceLine& line)
+{
+	size_t scanned = _start;
+
+	while (true) {
+		auto const start = _buffer.data() + _start;
+		auto newline = static_cast<char const*> (memchr(_buffer.data() + scanned, '\n', _end - scanned));
+		if (newline || (_eof && _start < _end)) {
+			line.data = start;
+			line.length = newline ? (newline - start) : (_end - _start);
+			line.number = ++_line_number;
+			line.offset = _offset;
+			size_t const consumed = newline ? (line.length + 1) : line.length;
+			_start += consumed;
+			_offset += consumed;
+			_history[_history_next] = line.offset;
+			_history_next = (_history_next + 1) % history_lines;
+			return true;
+		}
+
+		if (_eof) {
+			return false;
+		}
+
+		/* We need more data; first move what we have, and the recent lines that we
+		   keep for recall(), to the start of the buffer.
+		*/
+		int64_t const buffer_offset = _offset - _start;
+		auto const oldest = *std::min_element(_history.begin(), _history.end());
+		size_t const drop = std::min (static_cast<size_t>(std::max(oldest - buffer_offset, int64_t(0))), _start);
+		if (drop > 0) {
+			memmove (_buffer.data(), _buffer.data() + drop, _end - drop);
+			_end -= drop;
+			_start -= drop;
+		}
+
+		scanned = _end;
+
+		if (_end == _buffer.size()) {
+			/* This line is longer than the buffer */
+			_buffer.resize (_buffer.size() * 2);
+		}
+
+		size_t const N = fread (_buffer.data() + _end, 1, _buffer.size() - _end, _file);
+		if (N == 0) {
+			_eof = true;
+		}
+		_end += N;
+	}
+}
+
+bool
+FileLineSource::recall (int64_t offset, size_t length, string& text) const
+{
+	int64_t const buffer_offset = _offset - _start;
+	if (offset < buffer_offset || offset + static_cast<int64_t>(length) > buffer_offset + static_cast<int64_t>(_end)) {
+		return false;
+	}
+
+	text.assign (_buffer.data() + (offset - buffer_offset), length);
+	return true;
+}
+
+void
+LineHistory::add (SourceLine const& line, bool copy)
+{
+	auto& entry = _lines[_next];
+	entry.offset = line.offset;
+	entry.length = line.length;
+	if (copy) {
+		entry.text.assign (line.data, line.length);
+	}
+	_next = (_next + 1) % LineSource::history_lines;
+	_size = std::min (_size + 1, LineSource::history_lines);
+}
+
+std::list<string>
+LineHistory::get (LineSource const* source) const
+{
+	std::list<string> lines;
+	for (int i = 0; i < _size; ++i) {
+		auto const& entry = _lines[(_next - _size + i + LineSource::history_lines) % LineSource::history_lines];
+		string text;
+		if (!source) {
+			text = entry.text;
+		} else if (!source->recall(entry.offset, entry.length, text)) {
+			continue;
+		}
+		boost::algorithm::trim_right_if (text, boost::is_any_of("\r"));
+		remove_unicode_bom (text);
+		lines.push_back (text);
+	}
+	return lines;
+}
@@ -0,0 +1,238 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/line_source.h
+ *  @brief LineSource class and its implementations.
+ */
+
+#ifndef LIBSUB_LINE_SOURCE_H
+#define LIBSUB_LINE_SOURCE_H
+
+#include <boost/filesystem.hpp>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace sub {
+
+/** @class SourceLine
+ *  @brief A line of input, without its terminating newline.
+ *
+ *  The data is not owned by the SourceLine; it remains valid only until
+ *  the next call to LineSource::get() on the source that it came from.
+ */
+class SourceLine
+{
+public:
+	char const* data = nullptr;
+	size_t length = 0;
+	/** line number within the input, starting from 1 */
+	int number = 0;
+	/** offset in bytes of the start of this line from the start of the input */
+	int64_t offset = 0;
+
+	bool empty () const {
+		return length == 0;
+	}
+
+	std::string string () const {
+		return std::string (data, length);
+	}
+};
+
+/** @class LineSource
+ *  @brief Parent for classes which split some input into lines.
+ *
+ *  Lines are separated by \\n; any \\r is left for the caller to deal with.
+ *  A final line which has no \\n is returned as-is, but there is no empty
+ *  line after a final \\n.
+ */
+class LineSource
+{
+public:
+	virtual ~LineSource () {}
+
+	/** Get the next line of input.
+	 *  @param line Filled in with the line.
+	 *  @return false if there are no more lines.
+	 */
+	virtual bool get (SourceLine& line) = 0;
+
+	/** Get the text of a line which has already been returned by get().  Sources
+	 *  which can do this keep at least the last history_lines lines.
+	 *  @param offset Offset of the line.
+	 *  @param length Length of the line.
+	 *  @param text Filled in with the line.
+	 *  @return false if the line is no longer available.
+	 */
+	virtual bool recall (int64_t offset, size_t length, std::string& text) const {
+		(void) offset;
+		(void) length;
+		(void) text;
+		return false;
+	}
+
+	static int const history_lines = 5;
+};
+
+/** @class MemoryLineSource
+ *  @brief LineSource which reads from a block of memory.
+ */
+class MemoryLineSource : public LineSource
+{
+public:
+	/** @param data Input, which must remain valid for the lifetime of this object.
+	 *  @param size Size of data in bytes.
+	 *  @param first_line_number Line number to give the first line.
+	 *  @param first_offset Offset to give the first line.
+	 */
+	MemoryLineSource (char const* data, size_t size, int first_line_number = 1, int64_t first_offset = 0);
+	/** @param data Input, which will be owned by this object */
+	explicit MemoryLineSource (std::string data);
+
+	MemoryLineSource (MemoryLineSource const&) = delete;
+	MemoryLineSource& operator= (MemoryLineSource const&) = delete;
+
+	bool get (SourceLine& line) override;
+	bool recall (int64_t offset, size_t length, std::string& text) const override;
+
+	/** @return all of the input */
+	char const* data () const {
+		return _data;
+	}
+
+	/** @return size of all of the input in bytes */
+	size_t size () const {
+		return _size;
+	}
+
+protected:
+	MemoryLineSource () {}
+
+	void set_data (char const* data, size_t size);
+
+private:
+	std::string _owned;
+	char const* _data = nullptr;
+	size_t _size = 0;
+	size_t _position = 0;
+	int _line_number = 0;
+	int64_t _first_offset = 0;
+};
+
+/** @class MappedLineSource
+ *  @brief LineSource which memory-maps a file.
+ *
+ *  Where memory-mapping is not available the whole file is read into memory instead.
+ */
+class MappedLineSource : public MemoryLineSource
+{
+public:
+	explicit MappedLineSource (boost::filesystem::path file);
+	~MappedLineSource ();
+
+private:
+	void* _map = nullptr;
+	size_t _map_size = 0;
+	std::string _fallback;
+};
+
+/** @class FileLineSource
+ *  @brief LineSource which reads from a FILE* using a large buffer.
+ *
+ *  Lines may be of any length; the buffer grows as required.
+ */
+class FileLineSource : public LineSource
+{
+public:
+	/** @param file File to read from, which must remain open for the lifetime of this object.
+	 *  @param buffer_size Initial size of the read buffer in bytes.
+	 */
+	explicit FileLineSource (FILE* file, size_t buffer_size = 1024 * 1024);
+	/** @param file File to read from, which must remain open for the lifetime of this object.
+	 *  @param prefix Data which has already been read from the start of file.
+	 *  @param buffer_size Initial size of the read buffer in bytes.
+	 */
+	FileLineSource (FILE* file, std::string const& prefix, size_t buffer_size = 1024 * 1024);
+
+	FileLineSource (FileLineSource const&) = delete;
+	FileLineSource& operator= (FileLineSource const&) = delete;
+
+	bool get (SourceLine& line) override;
+	bool recall (int64_t offset, size_t length, std::string& text) const override;
+
+private:
+	FILE* _file;
+	std::vector<char> _buffer;
+	/** index into _buffer of the first byte that has not yet been returned */
+	size_t _start = 0;
+	/** index into _buffer of the end of the valid data */
+	size_t _end = 0;
+	bool _eof = false;
+	int _line_number = 0;
+	/** offset in the input of _buffer[_start] */
+	int64_t _offset = 0;
+	/** offsets of the starts of the last history_lines lines that were returned, which
+	 *  are kept in _buffer so that they can be recalled.
+	 */
+	std::array<int64_t, history_lines> _history = {};
+	int _history_next = 0;
+};
+
+/** @class LineHistory
+ *  @brief A note of the last few lines read from a LineSource, so that they can be given as
+ *  context if there is an error.
+ *
+ *  Where possible only the positions of the lines are kept, and their text is recalled
+ *  from the source when it is needed.
+ */
+class LineHistory
+{
+public:
+	/** @param line Line to add.
+	 *  @param copy true to keep a copy of the line's text, for when it cannot be recalled from a source.
+	 */
+	void add (SourceLine const& line, bool copy);
+
+	/** @param source Source that the lines came from, or null if they were copied.
+	 *  @return the lines, oldest first, each without any trailing \r or byte order mark.
+	 */
+	std::list<std::string> get (LineSource const* source) const;
+
+private:
+	struct Line
+	{
+		int64_t offset = 0;
+		size_t length = 0;
+		std::string text;
+	};
+
+	std::array<Line, LineSource::history_lines> _lines;
+	/** number of entries of _lines that are in use */
+	int _size = 0;
+	/** index into _lines of the next one to write */
+	int _next = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,102 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/online_collector.cc
+ *  @brief OnlineCollector class.
+ */
+
+#include "exceptions.h"
+#include "online_collector.h"
+#include <algorithm>
+
+using namespace sub;
+
+/** @param handler Handler to call with each Subtitle, in order of from time.
+ *  @param window Maximum number of fragments to hold back in order to sort input which is slightly out of order.
+ */
+OnlineCollector::OnlineCollector (Handler handler, size_t window)
+	: _handler (handler)
+	, _window (window)
+{
+
+}
+
+void
+OnlineCollector::add (RawSubtitle const& raw)
+{
+	add (RawSubtitle(raw));
+}
+
+/** Add a fragment.
+ *  @param raw Fragment, which must not start before any fragment which has already left the reorder window.
+ */
+void
+OnlineCollector::add (RawSubtitle&& raw)
+{
+	if (_released && raw.from < *_released) {
+		throw CollectError ("subtitle is too far out of order to be collected");
+	}
+
+	/* Insert after any fragments with the same from time so that they stay in the order that
+	   they were given to us, as the stable_sort in collect() would leave them.
+	*/
+	_pending.insert (std::upper_bound(_pending.begin(), _pending.end(), raw), std::move(raw));
+
+	if (_pending.size() > _window) {
+		auto next = std::move (_pending.front());
+		_pending.pop_front ();
+		release (std::move(next));
+	}
+}
+
+/** Say that there are no more fragments; everything that is left is given to the handler */
+void
+OnlineCollector::finish ()
+{
+	while (!_pending.empty()) {
+		auto next = std::move (_pending.front());
+		_pending.pop_front ();
+		release (std::move(next));
+	}
+
+	if (_current) {
+		_handler (std::move(_current.get()));
+		_current = boost::none;
+	}
+}
+
+/** Add a fragment which has come out of the reorder window to the Subtitle that is being built */
+void
+OnlineCollector::release (RawSubtitle&& raw)
+{
+	_released = raw.from;
+
+	if (_current && _current->same_metadata(raw)) {
+		if (!_current->lines.empty() && _current->lines.back().same_metadata(raw)) {
+			_current->lines.back().blocks.emplace_back (std::move(raw));
+		} else {
+			_current->lines.emplace_back (std::move(raw));
+		}
+	} else {
+		if (_current) {
+			_handler (std::move(_current.get()));
+		}
+		_current.emplace (std::move(raw));
+	}
+}
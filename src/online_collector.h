@@ -0,0 +1,75 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/online_collector.h
+ *  @brief OnlineCollector class.
+ */
+
+#ifndef LIBSUB_ONLINE_COLLECTOR_H
+#define LIBSUB_ONLINE_COLLECTOR_H
+
+#include "raw_subtitle.h"
+#include "subtitle.h"
+#include <boost/optional.hpp>
+#include <deque>
+#include <functional>
+
+namespace sub {
+
+/** @class OnlineCollector
+ *  @brief Collects RawSubtitles into Subtitles as they arrive, rather than all at once as collect() does.
+ *
+ *  RawSubtitles must be given to add() in non-decreasing order of their from time, except
+ *  that up to `window' of them are held back and sorted so that input which is only slightly
+ *  out of order is still accepted.  Each Subtitle is given to the handler as soon as a fragment
+ *  arrives which cannot be part of it, so only O(window) fragments are held at any time.
+ *
+ *  Given the same input, the Subtitles passed to the handler are the same as those that
+ *  collect() would return.
+ */
+class OnlineCollector
+{
+public:
+	typedef std::function<void (Subtitle)> Handler;
+
+	explicit OnlineCollector (Handler handler, size_t window = 16);
+
+	OnlineCollector (OnlineCollector const&) = delete;
+	OnlineCollector& operator= (OnlineCollector const&) = delete;
+
+	void add (RawSubtitle const& raw);
+	void add (RawSubtitle&& raw);
+	void finish ();
+
+private:
+	void release (RawSubtitle&& raw);
+
+	Handler _handler;
+	size_t _window;
+	/** fragments that are being held back, sorted by from time */
+	std::deque<RawSubtitle> _pending;
+	/** from time of the last fragment to leave _pending */
+	boost::optional<Time> _released;
+	/** Subtitle that is being built */
+	boost::optional<Subtitle> _current;
+};
+
+}
+
+#endif
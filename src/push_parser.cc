@@ -0,0 +1,101 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/push_parser.cc
+ *  @brief PushParser class.
+ */
+
+#include "line_source.h"
+#include "push_parser.h"
+#include <cstring>
+
+using namespace sub;
+
+/** @param handler Handler to call with each subtitle, in the order that they are found */
+PushParser::PushParser (Handler handler)
+	: _handler (handler)
+{
+
+}
+
+/** Give the parser some more input.
+ *  @param data Input, which need not be valid after this call returns.
+ *  @param size Size of data in bytes.
+ */
+void
+PushParser::feed (char const* data, size_t size)
+{
+	auto const end = data + size;
+	while (data < end) {
+		auto newline = static_cast<char const*> (memchr(data, '\n', end - data));
+		if (!newline) {
+			_partial.append (data, end - data);
+			return;
+		}
+
+		if (_partial.empty()) {
+			/* This line is all in the input so we can parse it from there */
+			line (data, newline - data);
+		} else {
+			_partial.append (data, newline - data);
+			line (_partial.data(), _partial.size());
+			_partial.clear ();
+		}
+
+		data = newline + 1;
+	}
+}
+
+/** Say that there is no more input; any unfinished cue at the end is given to the handler */
+void
+PushParser::finish ()
+{
+	if (!_partial.empty()) {
+		/* A final line without a newline */
+		line (_partial.data(), _partial.size());
+		_partial.clear ();
+	}
+
+	emit ();
+}
+
+void
+PushParser::line (char const* data, size_t length)
+{
+	SourceLine source_line;
+	source_line.data = data;
+	source_line.length = length;
+	source_line.number = ++_line_number;
+	source_line.offset = _offset;
+	_offset += length + 1;
+
+	if (process_line(source_line)) {
+		emit ();
+	}
+}
+
+void
+PushParser::emit ()
+{
+	auto& subs = pending ();
+	for (auto const& i: subs) {
+		_handler (i);
+	}
+	subs.clear ();
+}
@@ -0,0 +1,81 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/push_parser.h
+ *  @brief PushParser class.
+ */
+
+#ifndef LIBSUB_PUSH_PARSER_H
+#define LIBSUB_PUSH_PARSER_H
+
+#include "raw_subtitle.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace sub {
+
+class SourceLine;
+
+/** @class PushParser
+ *  @brief Parent for parsers which are given their input in arbitrary pieces.
+ *
+ *  Input is passed to feed() in chunks which may be split at any byte, even in the
+ *  middle of a line or a UTF-8 sequence.  Each complete line is parsed as soon as
+ *  it arrives, and subtitles are given to the handler as soon as the cue that they
+ *  are in is finished.  Errors in the input are thrown from feed() or finish(), and
+ *  the parser should not be used again after that.
+ */
+class PushParser
+{
+public:
+	typedef std::function<void (RawSubtitle const&)> Handler;
+
+	explicit PushParser (Handler handler);
+	virtual ~PushParser () {}
+
+	PushParser (PushParser const&) = delete;
+	PushParser& operator= (PushParser const&) = delete;
+
+	void feed (char const* data, size_t size);
+	void finish ();
+
+protected:
+	/** Parse one line of input.
+	 *  @return true if the line finished a cue.
+	 */
+	virtual bool process_line (SourceLine const& line) = 0;
+	/** @return subtitles which have been parsed but not yet given to the handler */
+	virtual std::vector<RawSubtitle>& pending () = 0;
+
+private:
+	void line (char const* data, size_t length);
+	void emit ();
+
+	Handler _handler;
+	/** the start of a line whose end we have not yet been given */
+	std::string _partial;
+	int _line_number = 0;
+	int64_t _offset = 0;
+};
+
+}
+
+#endif
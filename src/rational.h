@@ -17,6 +17,9 @@
 
 */
 
+#ifndef LIBSUB_RATIONAL_H
+#define LIBSUB_RATIONAL_H
+
 namespace sub {
 
 class Rational
@@ -44,3 +47,5 @@ bool operator== (Rational const & a, Rational const & b);
 Rational max (Rational const & a, Rational const & b);
 
 }
+
+#endif
@@ -18,50 +18,40 @@
 */
 
 #include "raw_convert.h"
-#include "locale_convert.h"
-#include <boost/algorithm/string.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <locale>
+#include <sstream>
 
 using std::string;
 
-static
-string
-make_local (string v)
-{
-	struct lconv* lc = localeconv ();
-	boost::algorithm::replace_all (v, ".", lc->decimal_point);
-	/* We hope it's ok not to add in thousands separators here */
-	return v;
-}
-
-/** @param v Numeric value as an ASCII string */
-static
-string
-make_raw (string v)
-{
-	struct lconv* lc = localeconv ();
-	/* thousands_sep may be . so remove them before changing decimal points */
-	boost::algorithm::replace_all (v, lc->thousands_sep, "");
-	boost::algorithm::replace_all (v, lc->decimal_point, ".");
-	return v;
-}
+/* These avoid the C library's locale-dependent number functions (and localeconv(),
+   which is not thread-safe) so that they can be called from any thread.
+*/
 
 template <>
 int
-sub::raw_convert (string v, int precision)
+sub::raw_convert (string v, int)
 {
-	return locale_convert<int> (make_local(v), precision);
+	return static_cast<int> (strtol(v.c_str(), nullptr, 10));
 }
 
 template <>
 float
-sub::raw_convert (string v, int precision)
+sub::raw_convert (string v, int)
 {
-	return locale_convert<float> (make_local(v), precision);
+	std::istringstream s (v);
+	s.imbue (std::locale::classic());
+	float f = 0;
+	s >> f;
+	return s.fail() ? 0 : f;
 }
 
 template <>
 string
-sub::raw_convert (unsigned long v, int precision)
+sub::raw_convert (unsigned long v, int)
 {
-	return make_raw (locale_convert<string>(v, precision));
+	char buffer[64];
+	snprintf (buffer, sizeof(buffer), "%lu", v);
+	return buffer;
 }
@@ -0,0 +1,233 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/raw_subtitle_track.cc
+ *  @brief RawSubtitleTrack class.
+ */
+
+#include "exceptions.h"
+#include "raw_subtitle_track.h"
+#include "retime.h"
+#include "sub_assert.h"
+#include <algorithm>
+#include <limits>
+
+using std::string;
+using std::vector;
+using namespace sub;
+
+void
+RawSubtitleTrack::push_back (RawSubtitle const& sub)
+{
+	SUB_ASSERT (_text.size() + sub.text.size() <= std::numeric_limits<uint32_t>::max());
+
+	_from.push_back (sub.from);
+	_to.push_back (sub.to);
+	_style_id.push_back (_styles.intern(Style(sub)));
+	_position.push_back (pack(sub.horizontal_position, sub.vertical_position));
+	_text.append (sub.text);
+	_text_offset.push_back (static_cast<uint32_t>(_text.size()));
+
+	if (sub.fade_up || sub.fade_down) {
+		Fade fade;
+		fade.index = _from.size() - 1;
+		fade.up = sub.fade_up;
+		fade.down = sub.fade_down;
+		_fades.push_back (fade);
+	}
+}
+
+/** Retime the from and to times of every fragment, and scale their fade times.
+ *  If any time cannot be retimed UnknownFrameRateError is thrown and the track is left as it was.
+ */
+void
+RawSubtitleTrack::retime (Transform const& transform)
+{
+	auto const can_apply = [&transform](Time const& t) { return transform.can_apply(t); };
+	auto const can_scale = [&transform](boost::optional<Time> const& t) { return !t || transform.can_scale(*t); };
+
+	bool const ok =
+		std::all_of(_from.begin(), _from.end(), can_apply) &&
+		std::all_of(_to.begin(), _to.end(), can_apply) &&
+		std::all_of(_fades.begin(), _fades.end(), [&can_scale](Fade const& f) { return can_scale(f.up) && can_scale(f.down); });
+
+	if (!ok) {
+		throw UnknownFrameRateError ();
+	}
+
+	transform.apply (_from.data(), _from.size());
+	transform.apply (_to.data(), _to.size());
+
+	for (auto& i: _fades) {
+		if (i.up) {
+			i.up = transform.scale (*i.up);
+		}
+		if (i.down) {
+			i.down = transform.scale (*i.down);
+		}
+	}
+}
+
+/** @param fragments Number of fragments to make space for.
+ *  @param text_bytes Total size of the text of those fragments in bytes.
+ */
+void
+RawSubtitleTrack::reserve (size_t fragments, size_t text_bytes)
+{
+	_from.reserve (fragments);
+	_to.reserve (fragments);
+	_style_id.reserve (fragments);
+	_position.reserve (fragments);
+	_text_offset.reserve (fragments + 1);
+	_text.reserve (text_bytes);
+}
+
+void
+RawSubtitleTrack::clear ()
+{
+	_from.clear ();
+	_to.clear ();
+	_style_id.clear ();
+	_position.clear ();
+	_text_offset.assign (1, 0);
+	_text.clear ();
+	_fades.clear ();
+	_styles.clear ();
+}
+
+/** Remove all but the first size fragments.  Their formatting stays in the style table,
+ *  so styles() may count some which are no longer used.
+ */
+void
+RawSubtitleTrack::truncate (size_t size)
+{
+	if (size >= _from.size()) {
+		return;
+	}
+
+	_from.resize (size);
+	_to.resize (size);
+	_style_id.resize (size);
+	_position.resize (size);
+	_text.resize (_text_offset[size]);
+	_text_offset.resize (size + 1);
+	while (!_fades.empty() && _fades.back().index >= size) {
+		_fades.pop_back ();
+	}
+}
+
+RawSubtitleTrack::Position
+RawSubtitleTrack::pack (HorizontalPosition const& h, VerticalPosition const& v)
+{
+	Position p;
+	p.horizontal_proportional = h.proportional;
+	p.vertical_proportional = v.proportional.get_value_or(0);
+	p.line = v.line.get_value_or(0);
+	p.lines = v.lines.get_value_or(0);
+	p.references = static_cast<uint8_t>(h.reference) | (static_cast<uint8_t>(v.reference.get_value_or(TOP_OF_SCREEN)) << 4);
+	p.flags = (v.proportional ? Position::HAS_VERTICAL_PROPORTIONAL : 0)
+		| (v.line ? Position::HAS_LINE : 0)
+		| (v.lines ? Position::HAS_LINES : 0)
+		| (v.reference ? Position::HAS_VERTICAL_REFERENCE : 0);
+	return p;
+}
+
+HorizontalPosition
+RawSubtitleTrack::horizontal_position (size_t i) const
+{
+	HorizontalPosition h;
+	h.reference = static_cast<HorizontalReference>(_position[i].references & 0xf);
+	h.proportional = _position[i].horizontal_proportional;
+	return h;
+}
+
+VerticalPosition
+RawSubtitleTrack::vertical_position (size_t i) const
+{
+	auto const& p = _position[i];
+	VerticalPosition v;
+	if (p.flags & Position::HAS_VERTICAL_PROPORTIONAL) {
+		v.proportional = p.vertical_proportional;
+	}
+	if (p.flags & Position::HAS_LINE) {
+		v.line = p.line;
+	}
+	if (p.flags & Position::HAS_LINES) {
+		v.lines = p.lines;
+	}
+	if (p.flags & Position::HAS_VERTICAL_REFERENCE) {
+		v.reference = static_cast<VerticalReference>(p.references >> 4);
+	}
+	return v;
+}
+
+/** @return fade details of fragment i, or nullptr if it has none */
+RawSubtitleTrack::Fade const*
+RawSubtitleTrack::fade (size_t i) const
+{
+	auto f = std::lower_bound (_fades.begin(), _fades.end(), i, [](Fade const& f, size_t index) { return f.index < index; });
+	return (f != _fades.end() && f->index == i) ? &(*f) : nullptr;
+}
+
+boost::optional<Time>
+RawSubtitleTrack::fade_up (size_t i) const
+{
+	auto f = fade (i);
+	return f ? f->up : boost::optional<Time>();
+}
+
+boost::optional<Time>
+RawSubtitleTrack::fade_down (size_t i) const
+{
+	auto f = fade (i);
+	return f ? f->down : boost::optional<Time>();
+}
+
+/** @return A RawSubtitle made from fragment i */
+RawSubtitle
+RawSubtitleTrack::operator[] (size_t i) const
+{
+	RawSubtitle sub;
+	sub.text = text (i);
+
+	style(i).apply (sub);
+
+	sub.horizontal_position = horizontal_position (i);
+	sub.vertical_position = vertical_position (i);
+	sub.from = _from[i];
+	sub.to = _to[i];
+
+	if (auto f = fade(i)) {
+		sub.fade_up = f->up;
+		sub.fade_down = f->down;
+	}
+
+	return sub;
+}
+
+vector<RawSubtitle>
+RawSubtitleTrack::subtitles () const
+{
+	vector<RawSubtitle> subs;
+	subs.reserve (size());
+	for (size_t i = 0; i < size(); ++i) {
+		subs.push_back ((*this)[i]);
+	}
+	return subs;
+}
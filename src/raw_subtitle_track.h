@@ -0,0 +1,165 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/raw_subtitle_track.h
+ *  @brief RawSubtitleTrack class.
+ */
+
+#ifndef LIBSUB_RAW_SUBTITLE_TRACK_H
+#define LIBSUB_RAW_SUBTITLE_TRACK_H
+
+#include "raw_subtitle.h"
+#include "style_table.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sub {
+
+class Transform;
+
+/** @class RawSubtitleTrack
+ *  @brief A compact store for many RawSubtitles.
+ *
+ *  Rather than a vector of RawSubtitle, which has a string and a number of optionals
+ *  for every fragment, this keeps each property in its own contiguous column.  The text
+ *  of all fragments is kept in one buffer, and the formatting of each fragment is
+ *  stored once per distinct combination and referred to by a small integer id.
+ *
+ *  operator[] and subtitles() give RawSubtitles for code which needs them.
+ */
+class RawSubtitleTrack
+{
+public:
+	void push_back (RawSubtitle const& sub);
+	void reserve (size_t fragments, size_t text_bytes);
+	void clear ();
+	void truncate (size_t size);
+	void retime (Transform const& transform);
+
+	size_t size () const {
+		return _from.size();
+	}
+
+	bool empty () const {
+		return _from.empty();
+	}
+
+	Time const& from (size_t i) const {
+		return _from[i];
+	}
+
+	Time const& to (size_t i) const {
+		return _to[i];
+	}
+
+	/** @return id of the formatting of fragment i; fragments with the same id have the same formatting */
+	uint32_t style_id (size_t i) const {
+		return _style_id[i];
+	}
+
+	/** @return number of distinct formattings in the track */
+	size_t styles () const {
+		return _styles.size();
+	}
+
+	/** @return formatting of fragment i */
+	Style const& style (size_t i) const {
+		return _styles[_style_id[i]];
+	}
+
+	StyleTable const& style_table () const {
+		return _styles;
+	}
+
+	/** @return Start of the UTF-8 text of fragment i, which is not terminated */
+	char const* text_data (size_t i) const {
+		return _text.data() + _text_offset[i];
+	}
+
+	/** @return Size of the text of fragment i in bytes */
+	size_t text_size (size_t i) const {
+		return _text_offset[i + 1] - _text_offset[i];
+	}
+
+	std::string text (size_t i) const {
+		return std::string (text_data(i), text_size(i));
+	}
+
+	HorizontalPosition horizontal_position (size_t i) const;
+	VerticalPosition vertical_position (size_t i) const;
+	boost::optional<Time> fade_up (size_t i) const;
+	boost::optional<Time> fade_down (size_t i) const;
+
+	RawSubtitle operator[] (size_t i) const;
+	std::vector<RawSubtitle> subtitles () const;
+
+private:
+	/** @class Position
+	 *  @brief Horizontal and vertical position of a fragment packed into 20 bytes.
+	 */
+	class Position
+	{
+	public:
+		enum {
+			HAS_VERTICAL_PROPORTIONAL = 0x1,
+			HAS_LINE = 0x2,
+			HAS_LINES = 0x4,
+			HAS_VERTICAL_REFERENCE = 0x8
+		};
+
+		float horizontal_proportional;
+		float vertical_proportional;
+		int32_t line;
+		int32_t lines;
+		/** horizontal reference in the low 4 bits, vertical in the high */
+		uint8_t references;
+		uint8_t flags;
+	};
+
+	/** @class Fade
+	 *  @brief Fade times of a fragment; only fragments which have fades have one of these.
+	 */
+	class Fade
+	{
+	public:
+		size_t index;
+		boost::optional<Time> up;
+		boost::optional<Time> down;
+	};
+
+	Fade const* fade (size_t i) const;
+	static Position pack (HorizontalPosition const& h, VerticalPosition const& v);
+
+	std::vector<Time> _from;
+	std::vector<Time> _to;
+	std::vector<uint32_t> _style_id;
+	std::vector<Position> _position;
+	/** offset into _text of the start of each fragment's text, plus one for the end of the last */
+	std::vector<uint32_t> _text_offset = { 0 };
+	std::string _text;
+	/** sorted by index */
+	std::vector<Fade> _fades;
+
+	StyleTable _styles;
+};
+
+}
+
+#endif
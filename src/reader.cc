@@ -17,17 +17,99 @@
 
 */
 
+#include "raw_subtitle_track.h"
 #include "reader.h"
 #include <string>
-#include <iostream>
 
 using std::string;
-using std::cout;
+using boost::optional;
 using namespace sub;
 
+
+/** @return The next subtitle from the input, or an empty optional if there are no more */
+optional<RawSubtitle>
+Reader::next ()
+{
+	while (_next == _subs.size()) {
+		if (!_more) {
+			return {};
+		}
+		/* Everything in _subs has been handed out, so we can drop it */
+		_subs.clear ();
+		_next = 0;
+		_more = read_more ();
+	}
+
+	return _subs[_next++];
+}
+
+
+/** Move all the subtitles that have not yet been returned by next() into a track.
+ *  Any that have not yet been read from the input go straight into the track
+ *  without being kept in this reader.
+ */
+void
+Reader::read (RawSubtitleTrack& track)
+{
+	for (; _next < _subs.size(); ++_next) {
+		track.push_back (_subs[_next]);
+	}
+	_subs.clear ();
+	_next = 0;
+
+	if (!_more) {
+		return;
+	}
+
+	_track = &track;
+	try {
+		read_all ();
+	} catch (...) {
+		_track = nullptr;
+		throw;
+	}
+	_track = nullptr;
+}
+
+
+/** Read everything that remains in the input into _subs */
+void
+Reader::read_all ()
+{
+	while (read_more()) {}
+	_more = false;
+}
+
+
+/** Note that a cue is starting, so that drop_cue() can remove anything it adds */
+void
+Reader::start_cue ()
+{
+	_cue_start = _track ? _track->size() : _subs.size();
+}
+
+
+/** Remove everything that has been added since the last call to start_cue(),
+ *  for when a cue has to be skipped part of the way through.
+ */
+void
+Reader::drop_cue ()
+{
+	if (_track) {
+		_track->truncate (_cue_start);
+	} else if (_cue_start < _subs.size()) {
+		_subs.erase (_subs.begin() + _cue_start, _subs.end());
+	}
+}
+
+
+/** Add a subtitle that has been read from the input */
 void
-Reader::warn (string m) const
+Reader::add (RawSubtitle const& sub)
 {
-	/* XXX */
-	cout << m << "\n";
+	if (_track) {
+		_track->push_back (sub);
+	} else {
+		_subs.push_back (sub);
+	}
 }
@@ -20,8 +20,12 @@
 #ifndef LIBSUB_READER_H
 #define LIBSUB_READER_H
 
+#include "diagnostic.h"
 #include "raw_subtitle.h"
+#include <boost/optional.hpp>
+#include <iterator>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -29,28 +33,158 @@ struct subrip_reader_convert_line_test;
 
 namespace sub {
 
+class RawSubtitleTrack;
+
+/** What a reader should do when it finds a cue that it cannot read */
+enum class ErrorPolicy
+{
+	/** throw an exception, so that nothing is read from the input */
+	THROW,
+	/** report a diagnostic, skip the cue and carry on with the next one */
+	SKIP_CUE
+};
+
 /** @class Reader
  *  @brief Parent for classes which can read particular subtitle formats.
+ *
+ *  Readers can be used in one of two ways.  Most constructors read the whole
+ *  input straight away, after which subtitles() returns everything that was found.
+ *  Constructors which take a shared_ptr to their input read nothing up front;
+ *  instead, next() (or a range-based for loop over the Reader) reads the input
+ *  a cue at a time, so that only the subtitles for one cue are held in memory.
  */
 class Reader
 {
 public:
 	virtual ~Reader () {}
 
+	/** @return Subtitles which have been read and are being held by this reader;
+	 *  for readers which read their whole input on construction this is all of them.
+	 */
 	std::vector<RawSubtitle> subtitles () const {
 		return _subs;
 	}
 
+	boost::optional<RawSubtitle> next ();
+	void read (RawSubtitleTrack& track);
+
 	virtual std::map<std::string, std::string> metadata () const {
 		return std::map<std::string, std::string> ();
 	}
 
+	/** Set a sink for diagnostics about the input that is read from now on.  Without a sink,
+	 *  diagnostics are discarded without their messages ever being made.
+	 */
+	void set_diagnostic_sink (std::shared_ptr<DiagnosticSink> sink) {
+		_diagnostic_sink = sink;
+	}
+
+	/** Set what to do about errors in the input that is read from now on */
+	void set_error_policy (ErrorPolicy policy) {
+		_error_policy = policy;
+	}
+
+	/** @class iterator
+	 *  @brief Input iterator which calls Reader::next() to get each RawSubtitle.
+	 */
+	class iterator
+	{
+	public:
+		typedef std::input_iterator_tag iterator_category;
+		typedef RawSubtitle value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef RawSubtitle const* pointer;
+		typedef RawSubtitle const& reference;
+
+		iterator () {}
+
+		explicit iterator (Reader* reader)
+			: _reader (reader)
+		{
+			++(*this);
+		}
+
+		RawSubtitle const& operator* () const {
+			return *_current;
+		}
+
+		RawSubtitle const* operator-> () const {
+			return _current.get_ptr();
+		}
+
+		iterator& operator++ () {
+			_current = _reader->next ();
+			if (!_current) {
+				_reader = nullptr;
+			}
+			return *this;
+		}
+
+		bool operator== (iterator const& other) const {
+			return _reader == other._reader;
+		}
+
+		bool operator!= (iterator const& other) const {
+			return _reader != other._reader;
+		}
+
+	private:
+		Reader* _reader = nullptr;
+		boost::optional<RawSubtitle> _current;
+	};
+
+	iterator begin () {
+		return iterator (this);
+	}
+
+	iterator end () {
+		return iterator ();
+	}
+
 protected:
 	friend struct ::subrip_reader_convert_line_test;
 
-	void warn (std::string) const;
+	/** Read some more of the input, adding any subtitles that are found to _subs.
+	 *  Implementations should try to stop after a complete cue has been read.
+	 *  @return false if the end of the input has been reached.
+	 */
+	virtual bool read_more () {
+		return false;
+	}
+
+	void read_all ();
+	void add (RawSubtitle const& sub);
+	void start_cue ();
+	void drop_cue ();
+
+	/** Report a warning to our diagnostic sink, if there is one.
+	 *  @param message Function returning the message, which is only called if there is a sink.
+	 */
+	template <class F>
+	void warn (DiagnosticCode code, boost::optional<int> line, boost::optional<int64_t> offset, F message) const {
+		if (_diagnostic_sink) {
+			_diagnostic_sink->report (Diagnostic(DiagnosticSeverity::WARNING, code, message(), line, offset));
+		}
+	}
+
+	/** Report a cue that had to be skipped because of an error */
+	void skipped_cue (int line, int64_t offset, std::string message) const {
+		if (_diagnostic_sink) {
+			_diagnostic_sink->report (Diagnostic(DiagnosticSeverity::ERROR, DiagnosticCode::BAD_CUE, message, line, offset));
+		}
+	}
 
 	std::vector<RawSubtitle> _subs;
+	/** index into _subs of the next subtitle that next() will return */
+	size_t _next = 0;
+	/** true if read_more() might find some more subtitles */
+	bool _more = true;
+	/** if not null, add() puts subtitles here rather than in _subs */
+	RawSubtitleTrack* _track = nullptr;
+	/** number of subtitles that had been added when the current cue started */
+	size_t _cue_start = 0;
+	std::shared_ptr<DiagnosticSink> _diagnostic_sink;
+	ErrorPolicy _error_policy = ErrorPolicy::THROW;
 };
 
 }
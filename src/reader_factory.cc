@@ -17,46 +17,202 @@
 
 */
 
+#include "compose.hpp"
+#include "exceptions.h"
+#include "line_source.h"
 #include "reader_factory.h"
+#include "ssa_reader.h"
 #include "stl_binary_reader.h"
 #include "stl_text_reader.h"
 #include "subrip_reader.h"
-#include "sub_assert.h"
+#include "thread_pool.h"
+#include "util.h"
+#include "web_vtt_reader.h"
 #include <boost/algorithm/string.hpp>
-#include <fstream>
+#include <algorithm>
+#include <cstdio>
 
 using std::string;
-using std::ifstream;
-using boost::algorithm::ends_with;
+using boost::algorithm::starts_with;
 using std::shared_ptr;
+using std::vector;
 using namespace sub;
 
-shared_ptr<Reader>
-sub::reader_factory (boost::filesystem::path file_name)
+/** Number of bytes from the start of a file that we look at to decide its format */
+static size_t const probe_size = 4096;
+
+static bool
+all_digits (string const& s)
+{
+	return !s.empty() && std::all_of(s.begin(), s.end(), [](char c) { return c >= '0' && c <= '9'; });
+}
+
+/** @return true if s looks like a line of text STL: a $ variable, a comment, or a subtitle line
+ *  starting with a H:M:S:F timecode.
+ */
+static bool
+stl_text_line (string const& s)
 {
-	string ext = file_name.extension().string();
-	transform (ext.begin(), ext.end(), ext.begin(), ::tolower);
-
-	if (ext == ".stl") {
-		/* Check the start of the DFC */
-		ifstream f (file_name.string().c_str ());
-		char buffer[11];
-		f.read (buffer, 11);
-		f.seekg (0);
-		if (f.gcount() == 11 && buffer[3] == 'S' && buffer[4] == 'T' && buffer[5] == 'L') {
-			return shared_ptr<Reader> (new STLBinaryReader (f));
-		} else {
-			return shared_ptr<Reader> (new STLTextReader (f));
+	if (starts_with(s, "$") || starts_with(s, "//")) {
+		return true;
+	}
+
+	vector<string> bits;
+	boost::algorithm::split (bits, s, boost::is_any_of(","));
+	if (bits.size() < 3) {
+		return false;
+	}
+
+	auto timecode = bits[0];
+	boost::algorithm::trim (timecode);
+	vector<string> parts;
+	boost::algorithm::split (parts, timecode, boost::is_any_of(":"));
+	return parts.size() == 4 && std::all_of(parts.begin(), parts.end(), all_digits);
+}
+
+/** Guess the format of some subtitles.
+ *  @param data The start of the subtitles (a few kilobytes is plenty).
+ *  @param size Size of data in bytes.
+ *  @param extension_hint Extension of the file that the subtitles came from (e.g. ".srt"),
+ *  which is used if the format cannot be decided from data.
+ */
+SubtitleFormat
+sub::probe_format (char const* data, size_t size, string extension_hint)
+{
+	/* Binary STL's DFC is STL25.01 or STL30.01 starting at byte 3 */
+	if (size >= 11 && data[3] == 'S' && data[4] == 'T' && data[5] == 'L') {
+		return SubtitleFormat::STL_BINARY;
+	}
+
+	/* Look at the first few non-blank lines */
+	vector<string> lines;
+	MemoryLineSource source (data, size);
+	SourceLine line;
+	while (lines.size() < 2 && source.get(line)) {
+		auto s = line.string();
+		remove_unicode_bom (s);
+		boost::algorithm::trim (s);
+		if (!s.empty()) {
+			lines.push_back (s);
+		}
+	}
+
+	if (!lines.empty()) {
+		if (starts_with(lines[0], "WEBVTT")) {
+			return SubtitleFormat::WEBVTT;
+		}
+		if (lines[0] == "[Script Info]") {
+			return SubtitleFormat::SSA;
+		}
+		if (lines.size() == 2 && all_digits(lines[0]) && lines[1].find("-->") != string::npos) {
+			return SubtitleFormat::SUBRIP;
 		}
+		if (stl_text_line(lines[0])) {
+			return SubtitleFormat::STL_TEXT;
+		}
+	}
+
+	transform (extension_hint.begin(), extension_hint.end(), extension_hint.begin(), ::tolower);
+	if (extension_hint == ".srt") {
+		return SubtitleFormat::SUBRIP;
+	} else if (extension_hint == ".vtt") {
+		return SubtitleFormat::WEBVTT;
+	} else if (extension_hint == ".ssa" || extension_hint == ".ass") {
+		return SubtitleFormat::SSA;
+	} else if (extension_hint == ".stl") {
+		return SubtitleFormat::STL_TEXT;
 	}
 
-	if (ext == ".srt") {
-		FILE* f = fopen (file_name.string().c_str(), "r");
-		SUB_ASSERT (f);
-		shared_ptr<Reader> r (new SubripReader(f));
-		fclose (f);
-		return r;
+	return SubtitleFormat::UNKNOWN;
+}
+
+/** Read a subtitle file, deciding its format from its contents or, failing that, its extension.
+ *  @param diagnostics Sink for diagnostics about the file, or null.
+ *  @param error_policy What to do about cues which cannot be read.
+ *  @return Reader, or null if the format could not be worked out.
+ */
+shared_ptr<Reader>
+sub::reader_factory (boost::filesystem::path file_name, shared_ptr<DiagnosticSink> diagnostics, ErrorPolicy error_policy)
+{
+	std::unique_ptr<FILE, int (*)(FILE*)> file (fopen(file_name.string().c_str(), "rb"), fclose);
+	if (!file) {
+		throw FileError (String::compose("Could not open %1", file_name.string()));
+	}
+
+	/* Read the start of the file once; the reader will carry on from there */
+	string prefix (probe_size, '\0');
+	prefix.resize (fread(&prefix[0], 1, probe_size, file.get()));
+
+	switch (probe_format(prefix.data(), prefix.size(), file_name.extension().string())) {
+	case SubtitleFormat::STL_BINARY:
+		return shared_ptr<Reader> (new STLBinaryReader(file.get(), prefix));
+	case SubtitleFormat::STL_TEXT:
+	{
+		FileLineSource source (file.get(), prefix);
+		return shared_ptr<Reader> (new STLTextReader(source, diagnostics));
+	}
+	case SubtitleFormat::SUBRIP:
+	{
+		FileLineSource source (file.get(), prefix);
+		return shared_ptr<Reader> (new SubripReader(source, diagnostics, error_policy));
+	}
+	case SubtitleFormat::WEBVTT:
+	{
+		FileLineSource source (file.get(), prefix);
+		return shared_ptr<Reader> (new WebVTTReader(source, diagnostics, error_policy));
+	}
+	case SubtitleFormat::SSA:
+	{
+		FileLineSource source (file.get(), prefix);
+		return shared_ptr<Reader> (new SSAReader(source));
+	}
+	case SubtitleFormat::UNKNOWN:
+		break;
 	}
 
 	return shared_ptr<Reader> ();
 }
+
+/** Read some files concurrently.  An error reading one file does not stop the others being read.
+ *  Diagnostics about each file are collected in its ReaderResult.
+ *  @param files Files to read.
+ *  @param executor Executor to read the files with.
+ *  @param error_policy What to do about cues which cannot be read.
+ *  @return One result for each file, in the same order as files.
+ */
+vector<ReaderResult>
+sub::reader_factory (vector<boost::filesystem::path> const& files, Executor& executor, ErrorPolicy error_policy)
+{
+	vector<ReaderResult> results (files.size());
+	vector<std::function<void ()>> tasks;
+
+	for (size_t i = 0; i < files.size(); ++i) {
+		results[i].file = files[i];
+		auto result = &results[i];
+		tasks.push_back ([result, error_policy]() {
+			auto diagnostics = std::make_shared<CollectingDiagnosticSink> ();
+			try {
+				result->reader = reader_factory (result->file, diagnostics, error_policy);
+			} catch (...) {
+				result->error = std::current_exception ();
+			}
+			result->diagnostics = diagnostics->diagnostics ();
+		});
+	}
+
+	executor.run (tasks);
+	return results;
+}
+
+/** Read some files concurrently.  An error reading one file does not stop the others being read.
+ *  @param files Files to read.
+ *  @param threads Number of threads to use, or 0 to use one per hardware thread.
+ *  @param error_policy What to do about cues which cannot be read.
+ *  @return One result for each file, in the same order as files.
+ */
+vector<ReaderResult>
+sub::reader_factory (vector<boost::filesystem::path> const& files, int threads, ErrorPolicy error_policy)
+{
+	ThreadPool pool (threads);
+	return reader_factory (files, pool, error_policy);
+}
@@ -17,14 +17,57 @@
 
 */
 
+#include "diagnostic.h"
+#include "reader.h"
 #include <memory>
 #include <boost/filesystem.hpp>
+#include <exception>
+#include <string>
+#include <vector>
 
 namespace sub {
 
-class Reader;
+class Executor;
+
+/** @class ReaderResult
+ *  @brief The result of reading one file of a batch.
+ */
+class ReaderResult
+{
+public:
+	boost::filesystem::path file;
+	/** reader for the file, or null if it could not be read or its format was not recognised */
+	std::shared_ptr<Reader> reader;
+	/** the exception that was thrown when reading the file, if there was one */
+	std::exception_ptr error;
+	/** diagnostics about the file */
+	std::vector<Diagnostic> diagnostics;
+};
+
+enum class SubtitleFormat
+{
+	UNKNOWN,
+	STL_BINARY,
+	STL_TEXT,
+	SUBRIP,
+	WEBVTT,
+	SSA
+};
+
+extern SubtitleFormat
+probe_format (char const* data, size_t size, std::string extension_hint = "");
 
 extern std::shared_ptr<Reader>
-reader_factory (boost::filesystem::path);
+reader_factory (
+	boost::filesystem::path,
+	std::shared_ptr<DiagnosticSink> diagnostics = std::shared_ptr<DiagnosticSink>(),
+	ErrorPolicy error_policy = ErrorPolicy::THROW
+	);
+
+extern std::vector<ReaderResult>
+reader_factory (std::vector<boost::filesystem::path> const& files, Executor& executor, ErrorPolicy error_policy = ErrorPolicy::THROW);
+
+extern std::vector<ReaderResult>
+reader_factory (std::vector<boost::filesystem::path> const& files, int threads = 0, ErrorPolicy error_policy = ErrorPolicy::THROW);
 
 }
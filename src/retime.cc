@@ -0,0 +1,313 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/retime.cc
+ *  @brief Transform class and retime() methods.
+ */
+
+#include "exceptions.h"
+#include "raw_subtitle.h"
+#include "raw_subtitle_track.h"
+#include "retime.h"
+#include "sub_assert.h"
+#include "subtitle.h"
+#include <algorithm>
+#include <cmath>
+
+using std::vector;
+using boost::optional;
+using namespace sub;
+
+/** Number of times to retime at once */
+static size_t const block = 256;
+
+#ifdef __SIZEOF_INT128__
+
+/** @return x * numerator / denominator rounded to the nearest integer, with halves rounded up;
+ *  denominator must be positive.
+ */
+static inline int64_t
+multiply_divide (int64_t x, int64_t numerator, int64_t denominator)
+{
+	__int128 const product = static_cast<__int128>(x) * numerator * 2 + denominator;
+	__int128 const divisor = static_cast<__int128>(denominator) * 2;
+	/* Division which rounds towards minus infinity */
+	__int128 quotient = product / divisor;
+	if ((product % divisor != 0) && (product < 0)) {
+		--quotient;
+	}
+	return static_cast<int64_t>(quotient);
+}
+
+#else
+
+static inline int64_t
+multiply_divide (int64_t x, int64_t numerator, int64_t denominator)
+{
+	/* Split x so that the part which is multiplied is less than denominator */
+	int64_t whole = x / denominator;
+	int64_t part = x % denominator;
+	if (part < 0) {
+		part += denominator;
+		--whole;
+	}
+	return whole * numerator + static_cast<int64_t>(std::floor(static_cast<long double>(part) * numerator / denominator + 0.5L));
+}
+
+#endif
+
+static int64_t
+gcd (int64_t a, int64_t b)
+{
+	a = std::abs (a);
+	b = std::abs (b);
+	while (b) {
+		auto const t = a % b;
+		a = b;
+		b = t;
+	}
+	return a;
+}
+
+Transform::Transform (int64_t origin, int64_t target, int64_t numerator, int64_t denominator, optional<Rational> rate)
+	: _origin (origin)
+	, _target (target)
+	, _numerator (numerator)
+	, _denominator (denominator)
+	, _rate (rate)
+{
+	SUB_ASSERT (_denominator != 0);
+
+	if (_denominator < 0) {
+		_numerator = -_numerator;
+		_denominator = -_denominator;
+	}
+
+	auto const divisor = gcd (_numerator, _denominator);
+	if (divisor > 1) {
+		_numerator /= divisor;
+		_denominator /= divisor;
+	}
+}
+
+/** Make a transform which moves all times by the same amount, e.g. to make the start of a programme zero.
+ *  @param from A time.
+ *  @param to Time that `from' should become.
+ */
+Transform
+Transform::shift (Time from, Time to)
+{
+	return Transform (from.ticks(), to.ticks(), 1, 1, optional<Rational>());
+}
+
+/** Make a transform for content which was made at one frame rate and will be played at another,
+ *  e.g. 24000/1001 to 25 for a PAL speed-up.  The retimed times are given the new rate.
+ */
+Transform
+Transform::change_rate (Rational from, Rational to)
+{
+	SUB_ASSERT (from.denominator != 0 && to.numerator != 0);
+	return Transform (0, 0, int64_t(from.numerator) * to.denominator, int64_t(from.denominator) * to.numerator, to);
+}
+
+/** Make a transform which moves a to a_new and b to b_new, and other times by the same stretch;
+ *  for example to correct subtitles which drift out of sync.  a and b must be different.
+ */
+Transform
+Transform::map (Time a, Time a_new, Time b, Time b_new)
+{
+	return Transform (a.ticks(), a_new.ticks(), b_new.ticks() - a_new.ticks(), b.ticks() - a.ticks(), optional<Rational>());
+}
+
+/** @return true if this transform only moves times by a whole number of seconds, which
+ *  is all that can be done to a time without a frame rate.
+ */
+bool
+Transform::whole_second_shift () const
+{
+	return _numerator == _denominator && !_rate && (_target - _origin) % Time::ticks_per_second == 0;
+}
+
+/** @return true if t can be transformed by this transform without throwing UnknownFrameRateError */
+bool
+Transform::can_apply (Time t) const
+{
+	return t.rate() || whole_second_shift();
+}
+
+/** @return true if the duration t can be scaled by this transform without throwing UnknownFrameRateError */
+bool
+Transform::can_scale (Time t) const
+{
+	return t.rate() || (_numerator == _denominator && !_rate);
+}
+
+Time
+Transform::operator() (Time t) const
+{
+	if (!can_apply(t)) {
+		throw UnknownFrameRateError ();
+	}
+
+	int64_t ticks = t.ticks ();
+	apply (&ticks, 1);
+	return Time::from_ticks (ticks, _rate ? _rate : t.rate());
+}
+
+/** @return a duration, scaled by this transform */
+Time
+Transform::scale (Time t) const
+{
+	if (!can_scale(t)) {
+		throw UnknownFrameRateError ();
+	}
+
+	int64_t ticks = t.ticks ();
+	scale (&ticks, 1);
+	return Time::from_ticks (ticks, _rate ? _rate : t.rate());
+}
+
+/** Transform some times in place.
+ *  @param ticks Times, in ticks.
+ *  @param n Number of times.
+ */
+void
+Transform::apply (int64_t* ticks, size_t n) const
+{
+	if (_numerator == _denominator) {
+		auto const offset = _target - _origin;
+		for (size_t i = 0; i < n; ++i) {
+			ticks[i] += offset;
+		}
+		return;
+	}
+
+	for (size_t i = 0; i < n; ++i) {
+		ticks[i] = _target + multiply_divide (ticks[i] - _origin, _numerator, _denominator);
+	}
+}
+
+/** Scale some durations in place, without moving them.
+ *  @param ticks Durations, in ticks.
+ *  @param n Number of durations.
+ */
+void
+Transform::scale (int64_t* ticks, size_t n) const
+{
+	if (_numerator == _denominator) {
+		return;
+	}
+
+	for (size_t i = 0; i < n; ++i) {
+		ticks[i] = multiply_divide (ticks[i], _numerator, _denominator);
+	}
+}
+
+/** Throw UnknownFrameRateError if any of the n times given by time(0) to time(n - 1) cannot be
+ *  transformed; this is done before anything is changed so that a throw leaves the times as they were.
+ */
+template <class F>
+static void
+check_apply (Transform const& transform, size_t n, F time)
+{
+	for (size_t i = 0; i < n; ++i) {
+		if (!transform.can_apply(time(i))) {
+			throw UnknownFrameRateError ();
+		}
+	}
+}
+
+/** Transform the n times given by time(0) to time(n - 1) (which return Time&), copying them a block
+ *  at a time into a contiguous array for the arithmetic.  The times must already have been checked
+ *  with check_apply().
+ */
+template <class F>
+static void
+apply_in_blocks (Transform const& transform, size_t n, F time)
+{
+	int64_t ticks[block];
+	for (size_t start = 0; start < n; start += block) {
+		auto const m = std::min (block, n - start);
+		for (size_t i = 0; i < m; ++i) {
+			ticks[i] = time(start + i).ticks();
+		}
+		transform.apply (ticks, m);
+		for (size_t i = 0; i < m; ++i) {
+			auto& t = time (start + i);
+			t = Time::from_ticks (ticks[i], transform.rate() ? transform.rate() : t.rate());
+		}
+	}
+}
+
+void
+Transform::apply (Time* times, size_t n) const
+{
+	auto time = [times](size_t i) -> Time& { return times[i]; };
+	check_apply (*this, n, time);
+	apply_in_blocks (*this, n, time);
+}
+
+template <class T>
+static void
+retime_vector (vector<T>& subs, Transform const& transform)
+{
+	auto from = [&subs](size_t i) -> Time& { return subs[i].from; };
+	auto to = [&subs](size_t i) -> Time& { return subs[i].to; };
+
+	check_apply (transform, subs.size(), from);
+	check_apply (transform, subs.size(), to);
+	for (auto const& i: subs) {
+		if ((i.fade_up && !transform.can_scale(*i.fade_up)) || (i.fade_down && !transform.can_scale(*i.fade_down))) {
+			throw UnknownFrameRateError ();
+		}
+	}
+
+	apply_in_blocks (transform, subs.size(), from);
+	apply_in_blocks (transform, subs.size(), to);
+
+	for (auto& i: subs) {
+		if (i.fade_up) {
+			i.fade_up = transform.scale (*i.fade_up);
+		}
+		if (i.fade_down) {
+			i.fade_down = transform.scale (*i.fade_down);
+		}
+	}
+}
+
+/** Retime the from and to times of some subtitles, and scale their fade times */
+void
+sub::retime (vector<RawSubtitle>& subs, Transform const& transform)
+{
+	retime_vector (subs, transform);
+}
+
+/** Retime the from and to times of some subtitles, and scale their fade times */
+void
+sub::retime (vector<Subtitle>& subs, Transform const& transform)
+{
+	retime_vector (subs, transform);
+}
+
+/** Retime the from and to times of the fragments in a track, and scale their fade times */
+void
+sub::retime (RawSubtitleTrack& track, Transform const& transform)
+{
+	track.retime (transform);
+}
@@ -0,0 +1,91 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/retime.h
+ *  @brief Transform class and retime() methods.
+ */
+
+#ifndef LIBSUB_RETIME_H
+#define LIBSUB_RETIME_H
+
+#include "sub_time.h"
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace sub {
+
+class RawSubtitle;
+class RawSubtitleTrack;
+class Subtitle;
+
+/** @class Transform
+ *  @brief A linear change to some times.
+ *
+ *  A time t becomes target + (t - origin) * numerator / denominator, calculated exactly
+ *  and then rounded to the nearest tick.  Fade times are durations, so they are only
+ *  scaled.
+ *
+ *  A time without a frame rate holds its frames as a count of ticks, so the only thing
+ *  which can be done to it is a shift by whole seconds; anything else throws
+ *  UnknownFrameRateError.
+ */
+class Transform
+{
+public:
+	/** Make a transform which leaves times as they are */
+	Transform () {}
+
+	static Transform shift (Time from, Time to);
+	static Transform change_rate (Rational from, Rational to);
+	static Transform map (Time a, Time a_new, Time b, Time b_new);
+
+	Time operator() (Time t) const;
+	Time scale (Time t) const;
+
+	void apply (int64_t* ticks, size_t n) const;
+	void apply (Time* times, size_t n) const;
+	void scale (int64_t* ticks, size_t n) const;
+
+	bool whole_second_shift () const;
+	bool can_apply (Time t) const;
+	bool can_scale (Time t) const;
+
+	/** @return rate to give the retimed times, or none to leave their rate as it was */
+	boost::optional<Rational> rate () const {
+		return _rate;
+	}
+
+private:
+	Transform (int64_t origin, int64_t target, int64_t numerator, int64_t denominator, boost::optional<Rational> rate);
+
+	int64_t _origin = 0;
+	int64_t _target = 0;
+	int64_t _numerator = 1;
+	int64_t _denominator = 1;
+	boost::optional<Rational> _rate;
+};
+
+void retime (std::vector<RawSubtitle>& subs, Transform const& transform);
+void retime (std::vector<Subtitle>& subs, Transform const& transform);
+void retime (RawSubtitleTrack& track, Transform const& transform);
+
+}
+
+#endif
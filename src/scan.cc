@@ -0,0 +1,324 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/scan.cc
+ *  @brief ByteSet class and functions to find structural bytes in text quickly.
+ *
+ *  Each SIMD implementation compares a block of input against every byte in the set,
+ *  ORs the results together and then finds the first set bit of the resulting mask.
+ *  Blocks are unaligned loads; the last part of the input is handled by loading the
+ *  last whole block again and ignoring the bytes that have already been checked.
+ */
+
+#include "scan.h"
+#include "sub_assert.h"
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#define LIBSUB_SCAN_X86
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) && defined(__aarch64__)
+#define LIBSUB_SCAN_NEON
+#include <arm_neon.h>
+#endif
+
+using std::string;
+using std::vector;
+using namespace sub;
+
+ByteSet::ByteSet (string const& bytes)
+{
+	memset (_table, 0, sizeof(_table));
+	for (auto i: bytes) {
+		auto const byte = static_cast<uint8_t>(i);
+		if (_table[byte]) {
+			continue;
+		}
+		SUB_ASSERT (_size < max_size);
+		_bytes[_size++] = byte;
+		_table[byte] = true;
+	}
+}
+
+namespace {
+
+typedef char const* (*FindFunction)(char const* begin, char const* end, ByteSet const& set);
+
+char const*
+find_scalar (char const* begin, char const* end, ByteSet const& set)
+{
+	auto p = begin;
+	while (p < end && !set.contains(*p)) {
+		++p;
+	}
+	return p;
+}
+
+#ifdef LIBSUB_SCAN_X86
+
+inline int
+match_sse2 (__m128i block, __m128i const* needles, int needles_size)
+{
+	auto match = _mm_cmpeq_epi8 (block, needles[0]);
+	for (int i = 1; i < needles_size; ++i) {
+		match = _mm_or_si128 (match, _mm_cmpeq_epi8(block, needles[i]));
+	}
+	return _mm_movemask_epi8 (match);
+}
+
+char const*
+find_sse2 (char const* begin, char const* end, ByteSet const& set)
+{
+	int const block_size = 16;
+
+	if (end - begin < block_size) {
+		return find_scalar (begin, end, set);
+	}
+
+	__m128i needles[ByteSet::max_size];
+	for (int i = 0; i < set.size(); ++i) {
+		needles[i] = _mm_set1_epi8 (static_cast<char>(set.bytes()[i]));
+	}
+
+	auto p = begin;
+	for (; end - p >= block_size; p += block_size) {
+		int const mask = match_sse2 (_mm_loadu_si128(reinterpret_cast<__m128i const*>(p)), needles, set.size());
+		if (mask) {
+			return p + __builtin_ctz(mask);
+		}
+	}
+
+	if (p < end) {
+		auto const last = end - block_size;
+		unsigned int const mask = match_sse2 (_mm_loadu_si128(reinterpret_cast<__m128i const*>(last)), needles, set.size()) >> (p - last);
+		if (mask) {
+			return p + __builtin_ctz(mask);
+		}
+	}
+
+	return end;
+}
+
+__attribute__((target("avx2"))) inline uint32_t
+match_avx2 (__m256i block, __m256i const* needles, int needles_size)
+{
+	auto match = _mm256_cmpeq_epi8 (block, needles[0]);
+	for (int i = 1; i < needles_size; ++i) {
+		match = _mm256_or_si256 (match, _mm256_cmpeq_epi8(block, needles[i]));
+	}
+	return static_cast<uint32_t>(_mm256_movemask_epi8(match));
+}
+
+__attribute__((target("avx2"))) char const*
+find_avx2 (char const* begin, char const* end, ByteSet const& set)
+{
+	int const block_size = 32;
+
+	if (end - begin < block_size) {
+		return find_sse2 (begin, end, set);
+	}
+
+	__m256i needles[ByteSet::max_size];
+	for (int i = 0; i < set.size(); ++i) {
+		needles[i] = _mm256_set1_epi8 (static_cast<char>(set.bytes()[i]));
+	}
+
+	auto p = begin;
+	for (; end - p >= block_size; p += block_size) {
+		auto const mask = match_avx2 (_mm256_loadu_si256(reinterpret_cast<__m256i const*>(p)), needles, set.size());
+		if (mask) {
+			return p + __builtin_ctz(mask);
+		}
+	}
+
+	if (p < end) {
+		auto const last = end - block_size;
+		auto const mask = match_avx2 (_mm256_loadu_si256(reinterpret_cast<__m256i const*>(last)), needles, set.size()) >> (p - last);
+		if (mask) {
+			return p + __builtin_ctz(mask);
+		}
+	}
+
+	return end;
+}
+
+#endif
+
+#ifdef LIBSUB_SCAN_NEON
+
+/** @return a mask with 4 bits for each byte of the block, set if the byte is in the set */
+inline uint64_t
+match_neon (uint8x16_t block, uint8x16_t const* needles, int needles_size)
+{
+	auto match = vceqq_u8 (block, needles[0]);
+	for (int i = 1; i < needles_size; ++i) {
+		match = vorrq_u8 (match, vceqq_u8(block, needles[i]));
+	}
+	return vget_lane_u64 (vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(match), 4)), 0);
+}
+
+char const*
+find_neon (char const* begin, char const* end, ByteSet const& set)
+{
+	int const block_size = 16;
+
+	if (end - begin < block_size) {
+		return find_scalar (begin, end, set);
+	}
+
+	uint8x16_t needles[ByteSet::max_size];
+	for (int i = 0; i < set.size(); ++i) {
+		needles[i] = vdupq_n_u8 (set.bytes()[i]);
+	}
+
+	auto p = begin;
+	for (; end - p >= block_size; p += block_size) {
+		auto const mask = match_neon (vld1q_u8(reinterpret_cast<uint8_t const*>(p)), needles, set.size());
+		if (mask) {
+			return p + (__builtin_ctzll(mask) >> 2);
+		}
+	}
+
+	if (p < end) {
+		auto const last = end - block_size;
+		auto const mask = match_neon (vld1q_u8(reinterpret_cast<uint8_t const*>(last)), needles, set.size()) >> ((p - last) * 4);
+		if (mask) {
+			return p + (__builtin_ctzll(mask) >> 2);
+		}
+	}
+
+	return end;
+}
+
+#endif
+
+FindFunction
+find_function (ScanImplementation implementation)
+{
+	switch (implementation) {
+	case ScanImplementation::SCALAR:
+		return find_scalar;
+#ifdef LIBSUB_SCAN_X86
+	case ScanImplementation::SSE2:
+		return find_sse2;
+	case ScanImplementation::AVX2:
+		return find_avx2;
+#endif
+#ifdef LIBSUB_SCAN_NEON
+	case ScanImplementation::NEON:
+		return find_neon;
+#endif
+	default:
+		break;
+	}
+
+	SUB_ASSERT (false);
+	return find_scalar;
+}
+
+}
+
+vector<ScanImplementation>
+sub::scan_implementations ()
+{
+	vector<ScanImplementation> all = { ScanImplementation::SCALAR };
+#ifdef LIBSUB_SCAN_X86
+	all.push_back (ScanImplementation::SSE2);
+	__builtin_cpu_init ();
+	if (__builtin_cpu_supports("avx2")) {
+		all.push_back (ScanImplementation::AVX2);
+	}
+#endif
+#ifdef LIBSUB_SCAN_NEON
+	all.push_back (ScanImplementation::NEON);
+#endif
+	return all;
+}
+
+ScanImplementation
+sub::best_scan_implementation ()
+{
+	static ScanImplementation const best = scan_implementations().back();
+	return best;
+}
+
+string
+sub::scan_implementation_name (ScanImplementation implementation)
+{
+	switch (implementation) {
+	case ScanImplementation::SCALAR:
+		return "scalar";
+	case ScanImplementation::SSE2:
+		return "SSE2";
+	case ScanImplementation::AVX2:
+		return "AVX2";
+	case ScanImplementation::NEON:
+		return "NEON";
+	}
+
+	return "";
+}
+
+char const*
+sub::find_first_of (ScanImplementation implementation, char const* begin, char const* end, ByteSet const& set)
+{
+	if (set.size() == 0) {
+		return end;
+	}
+
+	return find_function(implementation)(begin, end, set);
+}
+
+char const*
+sub::find_first_of (char const* begin, char const* end, ByteSet const& set)
+{
+	static FindFunction const best = find_function (best_scan_implementation());
+
+	if (set.size() == 0) {
+		return end;
+	} else if (set.size() == 1) {
+		/* The C library's memchr is already as fast as it can be */
+		auto p = memchr (begin, set.bytes()[0], end - begin);
+		return p ? static_cast<char const*>(p) : end;
+	}
+
+	return best (begin, end, set);
+}
+
+char const*
+sub::find_line_separator (char const* begin, char const* end)
+{
+	static char const separator[] = "\xe2\x80\xa8";
+
+	auto p = begin;
+	while (end - p >= static_cast<ptrdiff_t>(line_separator_size)) {
+		auto lead = static_cast<char const*>(memchr(p, separator[0], end - p - 2));
+		if (!lead) {
+			break;
+		}
+		if (lead[1] == separator[1] && lead[2] == separator[2]) {
+			return lead;
+		}
+		p = lead + 1;
+	}
+
+	return end;
+}
@@ -0,0 +1,105 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/scan.h
+ *  @brief ByteSet class and functions to find structural bytes in text quickly.
+ */
+
+#ifndef LIBSUB_SCAN_H
+#define LIBSUB_SCAN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sub {
+
+/** @class ByteSet
+ *  @brief A small set of bytes to look for with find_first_of().
+ *
+ *  Up to max_size bytes may be given; these are the delimiters which a reader
+ *  needs to stop at, such as newlines or the start of a tag.
+ */
+class ByteSet
+{
+public:
+	/** @param bytes Bytes to put in the set (at most max_size of them) */
+	explicit ByteSet (std::string const& bytes);
+
+	static int const max_size = 8;
+
+	bool contains (char c) const {
+		return _table[static_cast<uint8_t>(c)];
+	}
+
+	/** @return the bytes in the set */
+	uint8_t const* bytes () const {
+		return _bytes;
+	}
+
+	/** @return number of bytes in the set */
+	int size () const {
+		return _size;
+	}
+
+private:
+	uint8_t _bytes[max_size];
+	int _size = 0;
+	bool _table[256];
+};
+
+/** Ways of implementing find_first_of(), not all of which are available on every CPU */
+enum class ScanImplementation
+{
+	SCALAR,
+	SSE2,
+	AVX2,
+	NEON
+};
+
+/** Find the first byte in [begin, end) which is in a set, using the fastest
+ *  implementation that this CPU supports.  This is chosen once, at run time.
+ *  @return Pointer to the byte, or end if there is none.
+ */
+extern char const* find_first_of (char const* begin, char const* end, ByteSet const& set);
+
+/** Find the first byte in [begin, end) which is in a set, using a particular implementation.
+ *  @param implementation Implementation, which must be one of those returned by scan_implementations().
+ *  @return Pointer to the byte, or end if there is none.
+ */
+extern char const* find_first_of (ScanImplementation implementation, char const* begin, char const* end, ByteSet const& set);
+
+/** Find the first Unicode LINE SEPARATOR (U+2028, encoded in UTF-8) in [begin, end).
+ *  @return Pointer to the start of the separator, or end if there is none.
+ */
+extern char const* find_line_separator (char const* begin, char const* end);
+
+/** Size in bytes of a UTF-8 encoded U+2028 */
+size_t const line_separator_size = 3;
+
+/** @return implementations of find_first_of() that can be used on this CPU */
+extern std::vector<ScanImplementation> scan_implementations ();
+/** @return the implementation of find_first_of() that is used when none is specified */
+extern ScanImplementation best_scan_implementation ();
+extern std::string scan_implementation_name (ScanImplementation implementation);
+
+}
+
+#endif
@@ -18,14 +18,17 @@
 */
 
 #include "ssa_reader.h"
+#include "line_source.h"
 #include "util.h"
 #include "sub_assert.h"
 #include "raw_convert.h"
+#include "scan.h"
 #include "subtitle.h"
+#include "time_parser.h"
 #include "compose.hpp"
 #include <boost/algorithm/string.hpp>
-#include <boost/bind/bind.hpp>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <vector>
 
@@ -34,23 +37,45 @@ using std::vector;
 using std::map;
 using std::cout;
 using boost::optional;
-using boost::function;
 using namespace boost::algorithm;
-#if BOOST_VERSION >= 106100
-using namespace boost::placeholders;
-#endif
 using namespace sub;
 
 /** @param s Subtitle string encoded in UTF-8 */
 SSAReader::SSAReader (string s)
 {
-	this->read (boost::bind(&get_line_string, &s));
+	MemoryLineSource source (s.data(), s.size());
+	_source = &source;
+	read_all ();
+	_source = nullptr;
 }
 
 /** @param f Subtitle file encoded in UTF-8 */
 SSAReader::SSAReader (FILE* f)
 {
-	this->read (boost::bind (&get_line_file, f));
+	FileLineSource source (f);
+	_source = &source;
+	read_all ();
+	_source = nullptr;
+}
+
+/** Read everything from source.
+ *  @param source Source of lines of a subtitle file encoded in UTF-8.
+ */
+SSAReader::SSAReader (LineSource& source)
+{
+	_source = &source;
+	read_all ();
+	_source = nullptr;
+}
+
+/** Prepare to read source an event at a time, using next().
+ *  @param source Source of lines of a subtitle file encoded in UTF-8.
+ */
+SSAReader::SSAReader (std::shared_ptr<LineSource> source)
+	: _owned_source (source)
+	, _source (source.get())
+{
+
 }
 
 Colour
@@ -76,7 +101,7 @@ h_colour (string s)
 		);
 }
 
-class Style
+class SSAReader::Style
 {
 public:
 	Style ()
@@ -212,15 +237,11 @@ SSAReader::Context::update_horizontal_position(RawSubtitle& sub) const
 Time
 SSAReader::parse_time (string t) const
 {
-	vector<string> bits;
-	split (bits, t, is_any_of (":."));
-	SUB_ASSERT (bits.size() == 4);
-	return Time::from_hms (
-		raw_convert<int> (bits[0]),
-		raw_convert<int> (bits[1]),
-		raw_convert<int> (bits[2]),
-		raw_convert<int> (bits[3]) * 10
-		);
+	auto const result = sub::parse_time<SSATimeFormat> (t);
+	if (!result) {
+		throw SSAError (String::compose("Badly formatted time %1; expected %2", t, time_parse_expected<SSATimeFormat>(result.error)));
+	}
+	return result.time;
 }
 
 
@@ -339,13 +360,18 @@ SSAReader::parse_line(RawSubtitle base, string line, Context const& context)
 	/* Count the number of line breaks */
 	int line_breaks = 0;
 	if (line.length() > 0) {
-		for (size_t i = 0; i < line.length() - 1; ++i) {
-			if (line[i] == '\\' && (line[i+1] == 'n' || line[i+1] == 'N')) {
+		auto const end = line.data() + line.length() - 1;
+		for (auto p = line.data(); (p = static_cast<char const*>(memchr(p, '\\', end - p))); ++p) {
+			if (p[1] == 'n' || p[1] == 'N') {
 				++line_breaks;
 			}
 		}
 	}
 
+	static ByteSet const text_delimiters ("{\\\r\n");
+	static ByteSet const tag_delimiters ("}\\");
+	auto const line_end = line.data() + line.length();
+
 	/* There are vague indications that with ASS 1 point should equal 1 pixel */
 	double const line_size = current.font_size.proportional(context.play_res_y) * 1.2;
 
@@ -358,7 +384,10 @@ SSAReader::parse_line(RawSubtitle base, string line, Context const& context)
 			} else if (c == '\\') {
 				state = BACKSLASH;
 			} else if (c != '\r' && c != '\n') {
-				current.text += c;
+				/* Take this character and any others before the next one that we need to look at */
+				auto const run_end = find_first_of (line.data() + i, line_end, text_delimiters);
+				current.text.append (line.data() + i, run_end);
+				i = run_end - line.data() - 1;
 			}
 			break;
 		case TAG:
@@ -373,8 +402,12 @@ SSAReader::parse_line(RawSubtitle base, string line, Context const& context)
 
 			if (c == '}') {
 				state = TEXT;
-			} else {
+			} else if (c == '\\') {
 				tag += c;
+			} else {
+				auto const run_end = find_first_of (line.data() + i, line_end, tag_delimiters);
+				tag.append (line.data() + i, run_end);
+				i = run_end - line.data() - 1;
 			}
 			break;
 		case BACKSLASH:
@@ -424,155 +457,159 @@ SSAReader::parse_line(RawSubtitle base, string line, Context const& context)
 	return subs;
 }
 
-void
-SSAReader::read (function<optional<string> ()> get_line)
+bool
+SSAReader::read_more ()
 {
-	enum {
-		INFO,
-		STYLES,
-		EVENTS
-	} part = INFO;
-
-	int play_res_x = 288;
-	int play_res_y = 288;
-	map<string, Style> styles;
-	string style_format_line;
-	vector<string> event_format;
-
-	while (true) {
-		optional<string> line = get_line ();
-		if (!line) {
-			break;
+	if (!_source) {
+		return false;
+	}
+
+	SourceLine line;
+	while (_source->get(line)) {
+		if (process_line(line)) {
+			return true;
 		}
+	}
+
+	return false;
+}
 
-		trim (*line);
-		remove_unicode_bom (line);
+/** Parse one line of input, adding any subtitles that it contains to _subs.
+ *  @return true if this line was an event which gave some subtitles.
+ */
+bool
+SSAReader::process_line (SourceLine const& source_line)
+{
+	auto line = source_line.string();
+	trim (line);
+	remove_unicode_bom (line);
 
-		if (starts_with (*line, ";") || line->empty ()) {
-			continue;
-		}
+	if (starts_with (line, ";") || line.empty ()) {
+		return false;
+	}
 
-		if (starts_with (*line, "[")) {
-			/* Section heading */
-			if (line.get() == "[Script Info]") {
-				part = INFO;
-			} else if (line.get() == "[V4 Styles]" || line.get() == "[V4+ Styles]") {
-				part = STYLES;
-			} else if (line.get() == "[Events]") {
-				part = EVENTS;
-			}
-			continue;
+	if (starts_with (line, "[")) {
+		/* Section heading */
+		if (line == "[Script Info]") {
+			_part = Part::INFO;
+		} else if (line == "[V4 Styles]" || line == "[V4+ Styles]") {
+			_part = Part::STYLES;
+		} else if (line == "[Events]") {
+			_part = Part::EVENTS;
 		}
+		return false;
+	}
 
-		size_t const colon = line->find (":");
-		SUB_ASSERT (colon != string::npos);
-		string const type = line->substr (0, colon);
-		string body = line->substr (colon + 1);
-		trim (body);
-
-		switch (part) {
-		case INFO:
-			if (type == "PlayResX") {
-				play_res_x = raw_convert<int> (body);
-			} else if (type == "PlayResY") {
-				play_res_y = raw_convert<int> (body);
+	size_t const colon = line.find (":");
+	SUB_ASSERT (colon != string::npos);
+	string const type = line.substr (0, colon);
+	string body = line.substr (colon + 1);
+	trim (body);
+
+	switch (_part) {
+	case Part::INFO:
+		if (type == "PlayResX") {
+			_play_res_x = raw_convert<int> (body);
+		} else if (type == "PlayResY") {
+			_play_res_y = raw_convert<int> (body);
+		}
+		break;
+	case Part::STYLES:
+		if (type == "Format") {
+			_style_format_line = body;
+		} else if (type == "Style") {
+			SUB_ASSERT (!_style_format_line.empty ());
+			auto s = std::make_shared<Style>(_style_format_line, body);
+			_styles[s->name] = s;
+		}
+		break;
+	case Part::EVENTS:
+		if (type == "Format") {
+			split (_event_format, body, is_any_of (","));
+			for (auto& i: _event_format) {
+				trim (i);
 			}
-			break;
-		case STYLES:
-			if (type == "Format") {
-				style_format_line = body;
-			} else if (type == "Style") {
-				SUB_ASSERT (!style_format_line.empty ());
-				Style s (style_format_line, body);
-				styles[s.name] = s;
+		} else if (type == "Dialogue") {
+			SUB_ASSERT (!_event_format.empty ());
+			vector<string> event;
+			split (event, body, is_any_of (","));
+
+			/* There may be commas in the subtitle part; reassemble any extra parts
+			   from when we just split it.
+			*/
+			while (event.size() > _event_format.size()) {
+				string const ex = event.back ();
+				event.pop_back ();
+				event.back() += "," + ex;
 			}
-			break;
-		case EVENTS:
-			if (type == "Format") {
-				split (event_format, body, is_any_of (","));
-				for (auto& i: event_format) {
-					trim (i);
-				}
-			} else if (type == "Dialogue") {
-				SUB_ASSERT (!event_format.empty ());
-				vector<string> event;
-				split (event, body, is_any_of (","));
-
-				/* There may be commas in the subtitle part; reassemble any extra parts
-				   from when we just split it.
-				*/
-				while (event.size() > event_format.size()) {
-					string const ex = event.back ();
-					event.pop_back ();
-					event.back() += "," + ex;
-				}
 
-				SUB_ASSERT (!event.empty());
-				SUB_ASSERT (event_format.size() == event.size());
-
-				RawSubtitle sub;
-				optional<Style> style;
-				int left_margin = 0;
-				int right_margin = 0;
-
-				for (size_t i = 0; i < event.size(); ++i) {
-					trim (event[i]);
-					if (event_format[i] == "Start") {
-						sub.from = parse_time (event[i]);
-					} else if (event_format[i] == "End") {
-						sub.to = parse_time (event[i]);
-					} else if (event_format[i] == "Style") {
-						/* libass trims leading '*'s from style names, commenting that
-						   "they seem to mean literally nothing".  Go figure...
-						*/
-						trim_left_if (event[i], boost::is_any_of ("*"));
-						/* Use the specified style unless it's not defined, in which case use
-						 * "Default" (if it exists).
-						 */
-						if (styles.find(event[i]) != styles.end()) {
-							style = styles[event[i]];
-						} else if (styles.find("Default") != styles.end()) {
-							style = styles["Default"];
-						} else {
-							continue;
-						}
-						sub.font = style->font_name;
-						sub.font_size = FontSize::from_proportional(static_cast<float>(style->font_size) / play_res_y);
-						sub.colour = style->primary_colour;
-						sub.effect_colour = style->back_colour;
-						sub.bold = style->bold;
-						sub.italic = style->italic;
-						sub.underline = style->underline;
-						sub.effect = style->effect;
-						sub.horizontal_position.reference = style->horizontal_reference;
-						sub.vertical_position.reference = style->vertical_reference;
-						if (sub.vertical_position.reference != sub::VERTICAL_CENTRE_OF_SCREEN) {
-							sub.vertical_position.proportional = float(style->vertical_margin) / play_res_y;
-						}
-						left_margin = style->left_margin;
-						right_margin = style->right_margin;
-					} else if (event_format[i] == "MarginV") {
-						if (event[i] != "0" && sub.vertical_position.reference != sub::VERTICAL_CENTRE_OF_SCREEN) {
-							/* Override the style if its non-zero */
-							sub.vertical_position.proportional = raw_convert<float>(event[i]) / play_res_y;
-						}
-					} else if (event_format[i] == "MarginL") {
-						if (event[i] != "0") {
-							left_margin = raw_convert<int>(event[i]);
-						}
-					} else if (event_format[i] == "MarginR") {
-						if (event[i] != "0") {
-							right_margin = raw_convert<int>(event[i]);
-						}
-					} else if (event_format[i] == "Text") {
-						auto context = Context(play_res_x, play_res_y, style ? style->primary_colour : Colour(1, 1, 1), left_margin, right_margin);
-						for (auto j: parse_line(sub, event[i], context)) {
-							_subs.push_back (j);
-						}
+			SUB_ASSERT (!event.empty());
+			SUB_ASSERT (_event_format.size() == event.size());
+
+			RawSubtitle sub;
+			std::shared_ptr<const Style> style;
+			int left_margin = 0;
+			int right_margin = 0;
+
+			for (size_t i = 0; i < event.size(); ++i) {
+				trim (event[i]);
+				if (_event_format[i] == "Start") {
+					sub.from = parse_time (event[i]);
+				} else if (_event_format[i] == "End") {
+					sub.to = parse_time (event[i]);
+				} else if (_event_format[i] == "Style") {
+					/* libass trims leading '*'s from style names, commenting that
+					   "they seem to mean literally nothing".  Go figure...
+					*/
+					trim_left_if (event[i], boost::is_any_of ("*"));
+					/* Use the specified style unless it's not defined, in which case use
+					 * "Default" (if it exists).
+					 */
+					if (_styles.find(event[i]) != _styles.end()) {
+						style = _styles[event[i]];
+					} else if (_styles.find("Default") != _styles.end()) {
+						style = _styles["Default"];
+					} else {
+						continue;
+					}
+					sub.font = style->font_name;
+					sub.font_size = FontSize::from_proportional(static_cast<float>(style->font_size) / _play_res_y);
+					sub.colour = style->primary_colour;
+					sub.effect_colour = style->back_colour;
+					sub.bold = style->bold;
+					sub.italic = style->italic;
+					sub.underline = style->underline;
+					sub.effect = style->effect;
+					sub.horizontal_position.reference = style->horizontal_reference;
+					sub.vertical_position.reference = style->vertical_reference;
+					if (sub.vertical_position.reference != sub::VERTICAL_CENTRE_OF_SCREEN) {
+						sub.vertical_position.proportional = float(style->vertical_margin) / _play_res_y;
+					}
+					left_margin = style->left_margin;
+					right_margin = style->right_margin;
+				} else if (_event_format[i] == "MarginV") {
+					if (event[i] != "0" && sub.vertical_position.reference != sub::VERTICAL_CENTRE_OF_SCREEN) {
+						/* Override the style if its non-zero */
+						sub.vertical_position.proportional = raw_convert<float>(event[i]) / _play_res_y;
+					}
+				} else if (_event_format[i] == "MarginL") {
+					if (event[i] != "0") {
+						left_margin = raw_convert<int>(event[i]);
+					}
+				} else if (_event_format[i] == "MarginR") {
+					if (event[i] != "0") {
+						right_margin = raw_convert<int>(event[i]);
+					}
+				} else if (_event_format[i] == "Text") {
+					auto context = Context(_play_res_x, _play_res_y, style ? style->primary_colour : Colour(1, 1, 1), left_margin, right_margin);
+					for (auto j: parse_line(sub, event[i], context)) {
+						add (j);
 					}
 				}
 			}
+			return true;
 		}
-
 	}
+
+	return false;
 }
@@ -25,10 +25,14 @@
 #define LIBSUB_SSA_READER_H
 
 #include "reader.h"
-#include <boost/function.hpp>
+#include <map>
+#include <memory>
 
 namespace sub {
 
+class LineSource;
+class SourceLine;
+
 /** @class SSAReader
  *  @brief Reader for SubStation Alpha (SSA) and Advanced Substation Alpha (ASS) subtitles.
  *
@@ -40,6 +44,8 @@ class SSAReader : public Reader
 public:
 	SSAReader (FILE* f);
 	SSAReader (std::string subs);
+	explicit SSAReader (LineSource& source);
+	explicit SSAReader (std::shared_ptr<LineSource> source);
 
 	class Context
 	{
@@ -65,8 +71,27 @@ public:
 	static void parse_tag(RawSubtitle& sub, std::string style, Context const& context);
 
 private:
-	void read (boost::function<boost::optional<std::string> ()> get_line);
+	class Style;
+
+	bool read_more () override;
+	bool process_line (SourceLine const& line);
 	Time parse_time (std::string t) const;
+
+	std::shared_ptr<LineSource> _owned_source;
+	LineSource* _source = nullptr;
+
+	enum class Part {
+		INFO,
+		STYLES,
+		EVENTS
+	};
+
+	Part _part = Part::INFO;
+	int _play_res_x = 288;
+	int _play_res_y = 288;
+	std::string _style_format_line;
+	std::map<std::string, std::shared_ptr<Style>> _styles;
+	std::vector<std::string> _event_format;
 };
 
 }
@@ -21,10 +21,12 @@
 #include "exceptions.h"
 #include "iso6937.h"
 #include "stl_util.h"
+#include "timecode.h"
 #include "compose.hpp"
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/locale.hpp>
+#include <algorithm>
 #include <iostream>
 
 using std::map;
@@ -77,9 +79,9 @@ public:
 		return v;
 	}
 
-	Time get_timecode (int offset, int frame_rate) const
+	Time get_timecode (int offset, Rational rate) const
 	{
-		return Time::from_hmsf (_buffer[offset], _buffer[offset + 1], _buffer[offset + 2], _buffer[offset + 3], Rational (frame_rate, 1));
+		return Timecode (_buffer[offset], _buffer[offset + 1], _buffer[offset + 2], _buffer[offset + 3]).to_time (rate);
 	}
 
 protected:
@@ -111,42 +113,103 @@ private:
 class FILEInputReader : public InputReader
 {
 public:
-	FILEInputReader (FILE* in)
+	/** @param prefix Data which has already been read from the start of in */
+	FILEInputReader (FILE* in, string prefix = "")
 		: _in (in)
+		, _prefix (prefix)
 	{
 
 	}
 
 	void read (int size, string what)
 	{
-		size_t const N = fread (_buffer, 1, size, _in);
-		if (static_cast<int>(N) != size) {
+		int const from_prefix = std::min(size, static_cast<int>(_prefix.size() - _prefix_used));
+		std::copy (_prefix.begin() + _prefix_used, _prefix.begin() + _prefix_used + from_prefix, _buffer);
+		_prefix_used += from_prefix;
+
+		size_t const N = fread (_buffer + from_prefix, 1, size - from_prefix, _in);
+		if (static_cast<int>(N) != size - from_prefix) {
 			throw STLError (String::compose("Could not read %1 block from binary STL file", what));
 		}
 	}
 
 private:
 	FILE* _in;
+	string _prefix;
+	size_t _prefix_used = 0;
 };
 
 }
 
 STLBinaryReader::STLBinaryReader (istream& in)
 {
-	read (shared_ptr<InputReader>(new StreamInputReader(in)));
+	read_all (shared_ptr<InputReader>(new StreamInputReader(in)));
 }
 
 STLBinaryReader::STLBinaryReader (FILE* in)
 {
-	read (shared_ptr<InputReader>(new FILEInputReader(in)));
+	read_all (shared_ptr<InputReader>(new FILEInputReader(in)));
 }
 
-void STLBinaryReader::read (shared_ptr<InputReader> reader)
+/** @param in File to read from.
+ *  @param prefix Data which has already been read from the start of in.
+ */
+STLBinaryReader::STLBinaryReader (FILE* in, string prefix)
 {
+	read_all (shared_ptr<InputReader>(new FILEInputReader(in, prefix)));
+}
+
+/** Prepare to read a stream a TTI block at a time, using next().
+ *  The stream must be seekable, as the TTI blocks are scanned once on construction
+ *  to find out how far lines must be moved up to keep them on screen.
+ */
+STLBinaryReader::STLBinaryReader (shared_ptr<istream> in)
+	: _owned_in (in)
+	, _reader (new StreamInputReader(*in))
+{
+	read_gsi ();
+
+	auto const start = in->tellg ();
+	for (int i = 0; i < tti_blocks; ++i) {
+		_reader->read (128, "TTI");
+		if (_tables.comment_file_to_enum (_reader->get_int(15, 1)) == COMMENT_YES) {
+			continue;
+		}
+		auto const whole = _reader->get_string(16, 112);
+		int const lines = std::count(whole.begin(), whole.end(), '\x8a') + 1;
+		_highest_line = std::max(_highest_line, _reader->get_int(13, 1) + lines - 1);
+	}
+	in->seekg (start);
+
+	_line_correction = std::max(0, _highest_line - maximum_rows);
+}
+
+void
+STLBinaryReader::read_all (shared_ptr<InputReader> reader)
+{
+	_reader = reader;
+	read_gsi ();
+	Reader::read_all ();
+	_reader.reset ();
+
+	/* Fix line numbers so they don't go off the bottom of the screen */
+	if (_highest_line > maximum_rows) {
+		int correction = _highest_line - maximum_rows;
+		for (auto& i: _subs) {
+			*i.vertical_position.line -= correction;
+		}
+	}
+}
+
+void
+STLBinaryReader::read_gsi ()
+{
+	auto reader = _reader;
 	reader->read (1024, "GSI");
 
 	code_page_number = atoi (reader->get_string(0, 3).c_str());
-	frame_rate = stl_dfc_to_frame_rate (reader->get_string(3, 8));
+	rate = stl_dfc_to_rate (reader->get_string(3, 8));
+	frame_rate = timecode_base (rate);
 	display_standard = _tables.display_standard_file_to_enum (reader->get_string(11, 1));
 	language_group = _tables.language_group_file_to_enum (reader->get_string(12, 2));
 	language = _tables.language_file_to_enum (reader->get_string(14, 2));
@@ -186,15 +249,21 @@ void STLBinaryReader::read (shared_ptr<InputReader> reader)
 	publisher = reader->get_string(277, 32);
 	editor_name = reader->get_string(309, 32);
 	editor_contact_details = reader->get_string(341, 32);
+}
 
-	int highest_line = 0;
-	for (int i = 0; i < tti_blocks; ++i) {
+/** Read one TTI block */
+bool
+STLBinaryReader::read_more ()
+{
+	if (!_reader || _tti_read == tti_blocks) {
+		return false;
+	}
 
-		reader->read (128, "TTI");
+	auto reader = _reader;
+	reader->read (128, "TTI");
+	++_tti_read;
 
-		if (_tables.comment_file_to_enum (reader->get_int(15, 1)) == COMMENT_YES) {
-			continue;
-		}
+	if (_tables.comment_file_to_enum (reader->get_int(15, 1)) != COMMENT_YES) {
 
 		string const whole = reader->get_string(16, 112);
 
@@ -210,13 +279,14 @@ void STLBinaryReader::read (shared_ptr<InputReader> reader)
 
 		for (size_t j = 0; j < lines.size(); ++j) {
 			RawSubtitle sub;
-			sub.from = reader->get_timecode(5, frame_rate);
-			sub.to = reader->get_timecode(9, frame_rate);
+			sub.from = reader->get_timecode(5, rate);
+			sub.to = reader->get_timecode(9, rate);
 			/* XXX: vertical position of TTI extension blocks should be ignored (spec page 10) so this
 			 * is wrong if the EBN of this TTI block is not 255 (I think).
 			 */
 			sub.vertical_position.line = reader->get_int(13, 1) + j;
-			highest_line = std::max(highest_line, *sub.vertical_position.line);
+			_highest_line = std::max(_highest_line, *sub.vertical_position.line);
+			*sub.vertical_position.line -= _line_correction;
 			sub.vertical_position.lines = maximum_rows;
 			sub.vertical_position.reference = TOP_OF_SCREEN;
 			sub.italic = italic;
@@ -251,7 +321,7 @@ void STLBinaryReader::read (shared_ptr<InputReader> reader)
 				if (c <= 0x07 || (c >= 0x80 && c <= 0x83)) {
 					/* Colour, italic or underline control code */
 					sub.text = utf_to_utf<char> (iso6937_to_utf16 (text.c_str()));
-					_subs.push_back (sub);
+					add (sub);
 					text.clear ();
 				}
 
@@ -311,20 +381,14 @@ void STLBinaryReader::read (shared_ptr<InputReader> reader)
 
 			if (!text.empty ()) {
 				sub.text = utf_to_utf<char> (iso6937_to_utf16 (text.c_str()));
-				_subs.push_back (sub);
+				add (sub);
 			}
 
 			/* XXX: justification */
 		}
 	}
 
-	/* Fix line numbers so they don't go off the bottom of the screen */
-	if (highest_line > maximum_rows) {
-		int correction = highest_line - maximum_rows;
-		for (auto& i: _subs) {
-			*i.vertical_position.line -= correction;
-		}
-	}
+	return _tti_read < tti_blocks;
 }
 
 map<string, string>
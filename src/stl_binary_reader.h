@@ -20,6 +20,7 @@
 #ifndef LIBSUB_STL_BINARY_READER_H
 #define LIBSUB_STL_BINARY_READER_H
 
+#include "rational.h"
 #include "reader.h"
 #include "stl_binary_tables.h"
 #include <map>
@@ -37,11 +38,16 @@ class STLBinaryReader : public Reader
 public:
 	explicit STLBinaryReader (std::istream& in);
 	explicit STLBinaryReader (FILE* in);
+	STLBinaryReader (FILE* in, std::string prefix);
+	explicit STLBinaryReader (std::shared_ptr<std::istream> in);
 
 	std::map<std::string, std::string> metadata () const override;
 
 	int code_page_number;
+	/** frames per second of timecode, e.g. 24 for 24000/1001 */
 	int frame_rate;
+	/** exact frame rate */
+	Rational rate = Rational (25, 1);
 	DisplayStandard display_standard;
 	LanguageGroup language_group;
 	Language language;
@@ -71,9 +77,18 @@ public:
 	std::string editor_contact_details;
 
 private:
-	void read (std::shared_ptr<InputReader> reader);
+	void read_all (std::shared_ptr<InputReader> reader);
+	void read_gsi ();
+	bool read_more () override;
 
 	STLBinaryTables _tables;
+	std::shared_ptr<std::istream> _owned_in;
+	std::shared_ptr<InputReader> _reader;
+	/** number of TTI blocks that have been read so far */
+	int _tti_read = 0;
+	int _highest_line = 0;
+	/** amount to move each line up by to keep it on screen */
+	int _line_correction = 0;
 };
 
 }
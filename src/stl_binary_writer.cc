@@ -27,6 +27,7 @@
 #include "stl_util.h"
 #include "compose.hpp"
 #include "sub_assert.h"
+#include "timecode.h"
 #include <boost/locale.hpp>
 #include <boost/algorithm/string.hpp>
 #include <cmath>
@@ -90,13 +91,8 @@ put_int_as_string (char* p, int v, unsigned int n)
 		SUB_ASSERT (false);
 	}
 
-	string s = buffer;
-
-	struct lconv* lc = localeconv ();
-	boost::algorithm::replace_all (s, lc->thousands_sep, "");
-	boost::algorithm::replace_all (s, lc->decimal_point, ".");
-
-	put_string (p, s);
+	/* %d never gives thousands separators, whatever the locale */
+	put_string (p, buffer);
 }
 
 static void
@@ -151,6 +147,9 @@ make_tti_blocks (vector<Subtitle> const& subtitles, STLBinaryTables const& table
 	static int const tti_size = 128;
 	vector<char*> tti;
 
+	/* Timecodes are written at the rate that the disk format code will give */
+	auto const rate = stl_dfc_to_rate (stl_frame_rate_to_dfc(frames_per_second));
+
 	/* Buffer to build the TTI blocks in */
 	char buffer[tti_size];
 
@@ -230,15 +229,17 @@ make_tti_blocks (vector<Subtitle> const& subtitles, STLBinaryTables const& table
 		/* Cumulative status */
 		put_int_as_int (buffer + 4, tables.cumulative_status_enum_to_file (CUMULATIVE_STATUS_NOT_CUMULATIVE), 1);
 		/* Time code in */
-		put_int_as_int (buffer + 5, i.from.hours(), 1);
-		put_int_as_int (buffer + 6, i.from.minutes(), 1);
-		put_int_as_int (buffer + 7, i.from.seconds(), 1);
-		put_int_as_int (buffer + 8, i.from.frames_at(sub::Rational(frames_per_second * 1000, 1000)), 1);
+		auto const in = Timecode::from_time (i.from, rate);
+		put_int_as_int (buffer + 5, in.hours, 1);
+		put_int_as_int (buffer + 6, in.minutes, 1);
+		put_int_as_int (buffer + 7, in.seconds, 1);
+		put_int_as_int (buffer + 8, in.frames, 1);
 		/* Time code out */
-		put_int_as_int (buffer + 9, i.to.hours(), 1);
-		put_int_as_int (buffer + 10, i.to.minutes(), 1);
-		put_int_as_int (buffer + 11, i.to.seconds(), 1);
-		put_int_as_int (buffer + 12, i.to.frames_at(sub::Rational(frames_per_second * 1000, 1000)), 1);
+		auto const out = Timecode::from_time (i.to, rate);
+		put_int_as_int (buffer + 9, out.hours, 1);
+		put_int_as_int (buffer + 10, out.minutes, 1);
+		put_int_as_int (buffer + 11, out.seconds, 1);
+		put_int_as_int (buffer + 12, out.frames, 1);
 		/* Vertical position */
 		put_int_as_int (buffer + 13, top.get(), 1);
 
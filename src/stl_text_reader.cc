@@ -19,6 +19,9 @@
 
 #include "stl_text_reader.h"
 #include "compose.hpp"
+#include "line_source.h"
+#include "scan.h"
+#include "time_parser.h"
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <vector>
@@ -36,113 +39,197 @@ using boost::optional;
 using boost::lexical_cast;
 using namespace sub;
 
-STLTextReader::STLTextReader (istream& in)
+/** Read the whole of an input stream.
+ *  @param diagnostics Sink for diagnostics about the input, or null.
+ */
+STLTextReader::STLTextReader (istream& in, std::shared_ptr<DiagnosticSink> diagnostics)
+{
+	set_diagnostic_sink (diagnostics);
+	setup ();
+	_in = &in;
+	read_all ();
+	_in = nullptr;
+}
+
+/** Prepare to read a stream a line at a time, using next() */
+STLTextReader::STLTextReader (std::shared_ptr<istream> in)
+	: _owned_in (in)
+	, _in (in.get())
+{
+	setup ();
+}
+
+/** Read everything from source.
+ *  @param diagnostics Sink for diagnostics about the input, or null.
+ */
+STLTextReader::STLTextReader (LineSource& source, std::shared_ptr<DiagnosticSink> diagnostics)
+{
+	set_diagnostic_sink (diagnostics);
+	setup ();
+	_source = &source;
+	read_all ();
+	_source = nullptr;
+}
+
+void
+STLTextReader::setup ()
 {
 	/* This reader extracts no information about where the subtitle
 	   should be on screen, so its reference is TOP_OF_SUBTITLE.
 	*/
 	_subtitle.vertical_position.line = 0;
 	_subtitle.vertical_position.reference = TOP_OF_SUBTITLE;
+}
 
-	while (in.good ()) {
+bool
+STLTextReader::read_more ()
+{
+	if (_source) {
+		SourceLine line;
+		while (_source->get(line)) {
+			_line_number = line.number;
+			_line_offset = line.offset;
+			if (process_line(line.string())) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	if (!_in) {
+		return false;
+	}
+
+	while (_in->good ()) {
 		string line;
-		getline (in, line);
-		if (!in.good ()) {
-			return;
+		getline (*_in, line);
+		if (!_in->good ()) {
+			return false;
 		}
 
-		trim (line);
+		++_line_number;
+		_line_offset = _next_line_offset;
+		_next_line_offset += line.size() + 1;
 
-		if (starts_with (line, "//")) {
-			continue;
+		if (process_line(line)) {
+			return true;
 		}
+	}
 
-		if (line.size() > 0 && line[0] == '$') {
-			/* $ variables */
-			vector<string> bits;
-			split (bits, line, is_any_of ("="));
-			if (bits.size() == 2) {
-				string name = bits[0];
-				trim (name);
-				string value = bits[1];
-				trim (value);
-
-				set (name, value);
-			} else {
-				warn (String::compose ("Unrecognised line %1", line));
-			}
+	return false;
+}
+
+/** Parse one line of input, adding any subtitles that it contains to _subs.
+ *  @return true if some subtitles were added.
+ */
+bool
+STLTextReader::process_line (string line)
+{
+	trim (line);
+
+	if (starts_with (line, "//")) {
+		return false;
+	}
+
+	if (line.size() > 0 && line[0] == '$') {
+		/* $ variables */
+		vector<string> bits;
+		split (bits, line, is_any_of ("="));
+		if (bits.size() == 2) {
+			string name = bits[0];
+			trim (name);
+			string value = bits[1];
+			trim (value);
+
+			set (name, value);
 		} else {
-			/* "Normal" lines */
-			size_t divider[2];
-			divider[0] = line.find_first_of (",");
-			if (divider[0] != string::npos) {
-				divider[1] = line.find_first_of (",", divider[0] + 1);
-			}
+			warn_unrecognised_line (line);
+		}
+	} else {
+		/* "Normal" lines */
+		size_t divider[2];
+		divider[0] = line.find_first_of (",");
+		if (divider[0] != string::npos) {
+			divider[1] = line.find_first_of (",", divider[0] + 1);
+		}
 
-			if (divider[0] == string::npos || divider[1] == string::npos || divider[0] <= 1 || divider[1] >= line.length() - 1) {
-				warn (String::compose ("Unrecognised line %1", line));
-				continue;
-			}
+		if (divider[0] == string::npos || divider[1] == string::npos || divider[0] <= 1 || divider[1] >= line.length() - 1) {
+			warn_unrecognised_line (line);
+			return false;
+		}
 
-			string from_string = line.substr (0, divider[0] - 1);
-			trim (from_string);
-			string to_string = line.substr (divider[0] + 1, divider[1] - divider[0] - 1);
-			trim (to_string);
+		string from_string = line.substr (0, divider[0] - 1);
+		trim (from_string);
+		string to_string = line.substr (divider[0] + 1, divider[1] - divider[0] - 1);
+		trim (to_string);
 
-			optional<Time> from = time (from_string);
-			optional<Time> to = time (to_string);
+		optional<Time> from = time (from_string);
+		optional<Time> to = time (to_string);
 
-			if (!from || !to) {
-				warn (String::compose ("Unrecognised line %1", line));
-				continue;
-			}
+		if (!from || !to) {
+			warn_unrecognised_line (line);
+			return false;
+		}
+
+		_subtitle.from = from.get ();
+		_subtitle.to = to.get ();
 
-			_subtitle.from = from.get ();
-			_subtitle.to = to.get ();
-
-			/* Parse ^B/^I/^U */
-			string text = line.substr (divider[1] + 1);
-			for (size_t i = 0; i < text.length(); ++i) {
-				if (text[i] == '|') {
-					maybe_push ();
-					_subtitle.vertical_position.line = _subtitle.vertical_position.line.get() + 1;
-				} else if (text[i] == '^') {
-					maybe_push ();
-					if ((i + 1) < text.length()) {
-						switch (text[i + 1]) {
-						case 'B':
-							_subtitle.bold = !_subtitle.bold;
-							break;
-						case 'I':
-							_subtitle.italic = !_subtitle.italic;
-							break;
-						case 'U':
-							_subtitle.underline = !_subtitle.underline;
-							break;
-						}
+		/* Parse ^B/^I/^U */
+		string text = line.substr (divider[1] + 1);
+		for (size_t i = 0; i < text.length(); ++i) {
+			if (text[i] == '|') {
+				maybe_push ();
+				_subtitle.vertical_position.line = _subtitle.vertical_position.line.get() + 1;
+			} else if (text[i] == '^') {
+				maybe_push ();
+				if ((i + 1) < text.length()) {
+					switch (text[i + 1]) {
+					case 'B':
+						_subtitle.bold = !_subtitle.bold;
+						break;
+					case 'I':
+						_subtitle.italic = !_subtitle.italic;
+						break;
+					case 'U':
+						_subtitle.underline = !_subtitle.underline;
+						break;
 					}
-					++i;
-				} else {
-					_subtitle.text += text[i];
 				}
+				++i;
+			} else {
+				static ByteSet const delimiters ("|^");
+				auto const run_end = find_first_of (text.data() + i, text.data() + text.length(), delimiters);
+				_subtitle.text.append (text.data() + i, run_end);
+				i = run_end - text.data() - 1;
 			}
-
-			maybe_push ();
 		}
+
+		maybe_push ();
 	}
+
+	return !_subs.empty ();
 }
 
 optional<Time>
 STLTextReader::time (string t) const
 {
-	vector<string> b;
-	split (b, t, is_any_of (":"));
-	if (b.size() != 4) {
-		warn (String::compose ("Unrecognised time %1", t));
+	auto const result = parse_time<STLTextTimeFormat> (t);
+	if (!result) {
+		warn (DiagnosticCode::UNRECOGNISED_TIME, _line_number, _line_offset, [&t, &result]() {
+			return String::compose ("Unrecognised time %1; expected %2", t, time_parse_expected<STLTextTimeFormat>(result.error));
+		});
 		return optional<Time> ();
 	}
 
-	return sub::Time::from_hmsf (lexical_cast<int> (b[0]), lexical_cast<int> (b[1]), lexical_cast<int> (b[2]), lexical_cast<int> (b[3]));
+	return result.time;
+}
+
+void
+STLTextReader::warn_unrecognised_line (string const& line) const
+{
+	warn (DiagnosticCode::UNRECOGNISED_LINE, _line_number, _line_offset, [&line]() {
+		return String::compose ("Unrecognised line %1", line);
+	});
 }
 
 void
@@ -165,7 +252,7 @@ void
 STLTextReader::maybe_push ()
 {
 	if (!_subtitle.text.empty ()) {
-		_subs.push_back (_subtitle);
+		add (_subtitle);
 		_subtitle.text.clear ();
 		_subtitle.vertical_position.line = 0;
 	}
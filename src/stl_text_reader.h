@@ -23,23 +23,41 @@
 #include "reader.h"
 #include <boost/optional.hpp>
 #include <iostream>
+#include <memory>
 
 namespace sub {
 
+class LineSource;
+
 /** @class STLTextReader
  *  @brief A class to read textual STL files
  */
 class STLTextReader : public Reader
 {
 public:
-	STLTextReader (std::istream &);
+	explicit STLTextReader (std::istream &, std::shared_ptr<DiagnosticSink> diagnostics = std::shared_ptr<DiagnosticSink>());
+	explicit STLTextReader (std::shared_ptr<std::istream>);
+	explicit STLTextReader (LineSource& source, std::shared_ptr<DiagnosticSink> diagnostics = std::shared_ptr<DiagnosticSink>());
 
 private:
+	void setup ();
+	bool read_more () override;
+	bool process_line (std::string line);
 	void set (std::string name, std::string value);
 	void maybe_push ();
 	boost::optional<Time> time (std::string t) const;
+	void warn_unrecognised_line (std::string const& line) const;
 
+	std::shared_ptr<std::istream> _owned_in;
+	std::istream* _in = nullptr;
+	LineSource* _source = nullptr;
 	RawSubtitle _subtitle;
+	/** number of the line that is being processed */
+	int _line_number = 0;
+	/** offset of the line that is being processed */
+	int64_t _line_offset = 0;
+	/** offset of the next line to be read from _in */
+	int64_t _next_line_offset = 0;
 };
 
 }
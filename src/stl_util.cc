@@ -51,15 +51,22 @@ sub::stl_frame_rate_to_dfc (float r)
 
 float
 sub::stl_dfc_to_frame_rate (string s)
+{
+	return stl_dfc_to_rate(s).fraction();
+}
+
+/** @return the exact frame rate for a disk format code; STL23.01 is 24000/1001 */
+Rational
+sub::stl_dfc_to_rate (string s)
 {
 	if (s == "STL23.01") {
-		return 23.976;
+		return Rational (24000, 1001);
 	} else if (s == "STL24.01") {
-		return 24;
+		return Rational (24, 1);
 	} else if (s == "STL25.01") {
-		return 25;
+		return Rational (25, 1);
 	} else if (s == "STL30.01") {
-		return 30;
+		return Rational (30, 1);
 	}
 
 	throw STLError (String::compose ("Unknown disk format code %1 in binary STL file", s));
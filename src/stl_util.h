@@ -17,11 +17,13 @@
 
 */
 
+#include "rational.h"
 #include <string>
 
 namespace sub {
 
 std::string stl_frame_rate_to_dfc (float r);
 float stl_dfc_to_frame_rate (std::string s);
+Rational stl_dfc_to_rate (std::string s);
 
 }
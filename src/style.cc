@@ -0,0 +1,144 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/style.cc
+ *  @brief Style class.
+ */
+
+#include "raw_subtitle.h"
+#include "style.h"
+#include "subtitle.h"
+#include <boost/functional/hash.hpp>
+
+using namespace sub;
+
+Style::Style (RawSubtitle const& sub)
+	: font (sub.font)
+	, font_size (sub.font_size)
+	, effect (sub.effect)
+	, effect_colour (sub.effect_colour)
+	, colour (sub.colour)
+	, bold (sub.bold)
+	, italic (sub.italic)
+	, underline (sub.underline)
+{
+
+}
+
+Style::Style (Block const& block)
+	: font (block.font)
+	, font_size (block.font_size)
+	, effect (block.effect)
+	, effect_colour (block.effect_colour)
+	, colour (block.colour)
+	, bold (block.bold)
+	, italic (block.italic)
+	, underline (block.underline)
+{
+
+}
+
+/** Set the formatting of sub to this style */
+void
+Style::apply (RawSubtitle& sub) const
+{
+	sub.font = font;
+	sub.font_size = font_size;
+	sub.effect = effect;
+	sub.effect_colour = effect_colour;
+	sub.colour = colour;
+	sub.bold = bold;
+	sub.italic = italic;
+	sub.underline = underline;
+}
+
+/** Set the formatting of block to this style */
+void
+Style::apply (Block& block) const
+{
+	block.font = font;
+	block.font_size = font_size;
+	block.effect = effect;
+	block.effect_colour = effect_colour;
+	block.colour = colour;
+	block.bold = bold;
+	block.italic = italic;
+	block.underline = underline;
+}
+
+bool
+sub::operator== (Style const& a, Style const& b)
+{
+	return a.font == b.font && a.font_size == b.font_size && a.effect == b.effect && a.effect_colour == b.effect_colour
+		&& a.colour == b.colour && a.bold == b.bold && a.italic == b.italic && a.underline == b.underline;
+}
+
+bool
+sub::operator!= (Style const& a, Style const& b)
+{
+	return !(a == b);
+}
+
+/** Hash for use with boost::hash; styles which are equal give the same value */
+std::size_t
+sub::hash_value (Style const& style)
+{
+	std::size_t seed = 0;
+
+	auto optional = [&seed](bool set) {
+		boost::hash_combine (seed, set);
+	};
+
+	optional (static_cast<bool>(style.font));
+	if (style.font) {
+		boost::hash_combine (seed, *style.font);
+	}
+
+	optional (static_cast<bool>(style.font_size.proportional()));
+	if (style.font_size.proportional()) {
+		boost::hash_combine (seed, *style.font_size.proportional());
+	}
+	optional (static_cast<bool>(style.font_size.points()));
+	if (style.font_size.points()) {
+		boost::hash_combine (seed, *style.font_size.points());
+	}
+
+	optional (static_cast<bool>(style.effect));
+	if (style.effect) {
+		boost::hash_combine (seed, static_cast<int>(*style.effect));
+	}
+
+	auto colour = [&seed](Colour const& c) {
+		boost::hash_combine (seed, c.r);
+		boost::hash_combine (seed, c.g);
+		boost::hash_combine (seed, c.b);
+	};
+
+	optional (static_cast<bool>(style.effect_colour));
+	if (style.effect_colour) {
+		colour (*style.effect_colour);
+	}
+	colour (style.colour);
+
+	boost::hash_combine (seed, style.bold);
+	boost::hash_combine (seed, style.italic);
+	boost::hash_combine (seed, style.underline);
+
+	return seed;
+}
@@ -0,0 +1,74 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/style.h
+ *  @brief Style class.
+ */
+
+#ifndef LIBSUB_STYLE_H
+#define LIBSUB_STYLE_H
+
+#include "colour.h"
+#include "effect.h"
+#include "font_size.h"
+#include <boost/optional.hpp>
+#include <string>
+
+namespace sub {
+
+class Block;
+class RawSubtitle;
+
+/** @class Style
+ *  @brief The formatting of some text: everything about a RawSubtitle or Block except
+ *  its text, position and timing.
+ */
+class Style
+{
+public:
+	Style ()
+		: colour (1, 1, 1)
+		, bold (false)
+		, italic (false)
+		, underline (false)
+	{}
+
+	explicit Style (RawSubtitle const& sub);
+	explicit Style (Block const& block);
+
+	void apply (RawSubtitle& sub) const;
+	void apply (Block& block) const;
+
+	boost::optional<std::string> font;
+	FontSize font_size;
+	boost::optional<Effect> effect;
+	boost::optional<Colour> effect_colour;
+	Colour colour;
+	bool bold;
+	bool italic;
+	bool underline;
+};
+
+bool operator== (Style const& a, Style const& b);
+bool operator!= (Style const& a, Style const& b);
+std::size_t hash_value (Style const& style);
+
+}
+
+#endif
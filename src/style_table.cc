@@ -0,0 +1,53 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/style_table.cc
+ *  @brief StyleTable class.
+ */
+
+#include "style_table.h"
+
+using namespace sub;
+
+/** @return id of style, adding it to the table if it is not already there */
+uint32_t
+StyleTable::intern (Style const& style)
+{
+	/* Consecutive fragments very often share a style */
+	if (_last < _styles.size() && _styles[_last] == style) {
+		return _last;
+	}
+
+	auto i = _ids.find (style);
+	if (i == _ids.end()) {
+		i = _ids.insert (std::make_pair(style, static_cast<uint32_t>(_styles.size()))).first;
+		_styles.push_back (style);
+	}
+
+	_last = i->second;
+	return _last;
+}
+
+void
+StyleTable::clear ()
+{
+	_styles.clear ();
+	_ids.clear ();
+	_last = 0;
+}
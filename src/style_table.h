@@ -0,0 +1,64 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/style_table.h
+ *  @brief StyleTable class.
+ */
+
+#ifndef LIBSUB_STYLE_TABLE_H
+#define LIBSUB_STYLE_TABLE_H
+
+#include "style.h"
+#include <boost/functional/hash.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace sub {
+
+/** @class StyleTable
+ *  @brief A set of distinct Styles, each of which is given a small integer id.
+ *
+ *  Two styles from the same table are equal if and only if their ids are equal.
+ */
+class StyleTable
+{
+public:
+	uint32_t intern (Style const& style);
+
+	Style const& operator[] (uint32_t id) const {
+		return _styles[id];
+	}
+
+	size_t size () const {
+		return _styles.size();
+	}
+
+	void clear ();
+
+private:
+	std::vector<Style> _styles;
+	std::unordered_map<Style, uint32_t, boost::hash<Style>> _ids;
+	/** id of the last style that was interned, which is likely to be the next one too */
+	uint32_t _last = 0;
+};
+
+}
+
+#endif
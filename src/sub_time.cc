@@ -20,6 +20,7 @@
 #include "sub_time.h"
 #include "sub_assert.h"
 #include "exceptions.h"
+#include "timecode.h"
 #include <cmath>
 #include <iomanip>
 #include <iostream>
@@ -31,67 +32,28 @@ using std::setfill;
 using boost::optional;
 using namespace sub;
 
-bool
-sub::operator< (sub::Time const & a, sub::Time const & b)
-{
-	if (a._seconds != b._seconds) {
-		return a._seconds < b._seconds;
-	}
-
-	if (!a._rate && !b._rate) {
-		/* Can compare if neither has a specified frame rate */
-		return a._frames < b._frames;
-	}
-
-	if ((a._rate && !b._rate) || (!a._rate && b._rate)) {
-		throw UnknownFrameRateError ();
-	}
-
-	return (a._frames * a._rate.get().numerator * b._rate.get().denominator) < (b._frames * b._rate.get().numerator * a._rate.get().denominator);
-}
+int64_t const Time::ticks_per_second;
 
-bool
-sub::operator> (sub::Time const & a, sub::Time const & b)
+/** @return the length of a frame at a given rate, in ticks */
+static int64_t
+ticks_per_frame (Rational rate)
 {
-	if (a._seconds != b._seconds) {
-		return a._seconds > b._seconds;
-	}
-
-	if (!a._rate && !b._rate) {
-		/* Can compare if neither has a specified frame rate */
-		return a._frames > b._frames;
-	}
-
-	if ((a._rate && !b._rate) || (!a._rate && b._rate)) {
-		throw UnknownFrameRateError ();
-	}
-
-	return (a._frames * a._rate.get().numerator * b._rate.get().denominator) > (b._frames * b._rate.get().numerator * a._rate.get().denominator);
+	return frames_to_ticks (1, rate);
 }
 
-bool
-sub::operator== (sub::Time const & a, sub::Time const & b)
+/** Check that a time with a rate and one without can be compared, which they can only
+ *  be if they are in different seconds.
+ */
+void
+Time::check_mixed (Time const & a, Time const & b)
 {
-	if (!a._rate && !b._rate) {
-		/* Can compare if neither has a specified frame rate */
-		return (a._seconds == b._seconds && a._frames == b._frames);
-	}
+	auto whole_seconds = [](int64_t ticks) {
+		return ticks >= 0 ? ticks / ticks_per_second : (ticks - ticks_per_second + 1) / ticks_per_second;
+	};
 
-	if ((a._rate && !b._rate) || (!a._rate && b._rate)) {
+	if (whole_seconds(a._ticks) == whole_seconds(b._ticks)) {
 		throw UnknownFrameRateError ();
 	}
-
-	if (a._seconds != b._seconds) {
-		return false;
-	}
-
-	return (a._frames * a._rate.get().numerator * b._rate.get().denominator) == (b._frames * b._rate.get().numerator * a._rate.get().denominator);
-}
-
-bool
-sub::operator!= (sub::Time const & a, sub::Time const & b)
-{
-	return !(a == b);
 }
 
 ostream&
@@ -100,7 +62,7 @@ sub::operator<< (ostream& s, Time const & t)
 	s << setw (2) << setfill('0') << t.hours() << ":"
 	  << setw (2) << setfill('0') << t.minutes() << ":"
 	  << setw (2) << setfill('0') << t.seconds() << ":"
-	  << t._frames;
+	  << (t._rate ? t.frames_at(t._rate.get()) : t._ticks % Time::ticks_per_second);
 
 	if (t._rate) {
 		s << " @ " << t._rate.get().numerator << "/" << t._rate.get().denominator;
@@ -112,21 +74,22 @@ sub::operator<< (ostream& s, Time const & t)
 int
 Time::hours () const
 {
-	return _seconds / 3600;
+	return _ticks / ticks_per_second / 3600;
 }
 
 int
 Time::minutes () const
 {
-	return (_seconds - hours() * 3600) / 60;
+	return (_ticks / ticks_per_second - hours() * 3600) / 60;
 }
 
 int
 Time::seconds () const
 {
-	return (_seconds - hours() * 3600 - minutes() * 60);
+	return (_ticks / ticks_per_second - hours() * 3600 - minutes() * 60);
 }
 
+/** @return the number of frames at rate in the part of this time after the last whole second */
 int
 Time::frames_at (Rational rate) const
 {
@@ -134,7 +97,9 @@ Time::frames_at (Rational rate) const
 		throw UnknownFrameRateError ();
 	}
 
-	return rint (double (_frames) * _rate.get().denominator * rate.numerator / (_rate.get().numerator * rate.denominator));
+	int64_t const part = _ticks % ticks_per_second;
+	int64_t const scale = int64_t (rate.denominator) * ticks_per_second;
+	return (part * rate.numerator * 2 + scale) / (scale * 2);
 }
 
 int
@@ -146,51 +111,62 @@ Time::milliseconds () const
 Time
 Time::from_hmsf (int h, int m, int s, int f, optional<Rational> rate)
 {
-	return Time (h * 3600 + m * 60 + s, f, rate);
+	int64_t const seconds = int64_t (h) * 3600 + m * 60 + s;
+	return Time (seconds * ticks_per_second + (rate ? frames_to_ticks(f, rate.get()) : f), rate);
 }
 
 Time
 Time::from_hms (int h, int m, int s, int ms)
 {
-	return Time (h * 3600 + m * 60 + s, ms, Rational (1000, 1));
+	return from_hmsf (h, m, s, ms, Rational (1000, 1));
 }
 
-/** Create a Time from a number of frames.
- *  rate must be integer.
- */
+/** Create a Time from a number of frames at any rate, including the NTSC ones such as 24000/1001 */
 Time
 Time::from_frames (int f, Rational rate)
 {
 	SUB_ASSERT (rate.denominator != 0);
-	SUB_ASSERT (rate.integer ());
-	return Time (f / rate.integer_fraction(), f % rate.integer_fraction(), rate);
+	return Time (frames_to_ticks(f, rate), rate);
+}
+
+Time
+Time::from_ticks (int64_t ticks, optional<Rational> rate)
+{
+	return Time (ticks, rate);
 }
 
 double
 Time::all_as_seconds () const
 {
-	return _seconds + double(milliseconds()) / 1000;
+	if (!_rate) {
+		throw UnknownFrameRateError ();
+	}
+
+	return double (_ticks) / ticks_per_second;
 }
 
-/** Add a time to this one.  Both *this and t must have a specified _rate */
+/** Add a time to this one.  Both *this and t must have a specified _rate.  The result
+ *  is in the higher of the two rates, rounded down to a whole frame.
+ */
 void
 Time::add (Time t)
 {
 	SUB_ASSERT (_rate);
 	SUB_ASSERT (t._rate);
 
-	Rational result_rate = max (*_rate, *t._rate);
-	*this = Time::from_frames((all_as_seconds() + t.all_as_seconds()) * result_rate.fraction(), result_rate);
+	Rational const result_rate = max (*_rate, *t._rate);
+	int64_t const frame = ticks_per_frame (result_rate);
+	_ticks = (_ticks + t._ticks) / frame * frame;
+	_rate = result_rate;
 }
 
+/** Multiply this time by a factor, rounding to the nearest frame at its rate */
 void
 Time::scale (float f)
 {
 	SUB_ASSERT (_rate);
 	SUB_ASSERT (_rate->denominator != 0);
-	SUB_ASSERT (_rate->integer ());
 
-	double const s = Time::all_as_seconds() * f;
-	_seconds = floor (s);
-	_frames = rint ((s - _seconds) * _rate->fraction());
+	int64_t const frame = ticks_per_frame (*_rate);
+	_ticks = llrint (_ticks * double(f) / frame) * frame;
 }
@@ -22,17 +22,33 @@
 
 #include "rational.h"
 #include <boost/optional.hpp>
+#include <cstdint>
 
 namespace sub {
 
+/** @class Time
+ *  @brief A time, held as a count of ticks of which there are ticks_per_second in a second.
+ *
+ *  ticks_per_second is divisible by all the usual frame rates (including the NTSC ones
+ *  such as 24000/1001 and 30000/1001) and by 1000, so times in frames or milliseconds are
+ *  held exactly and comparisons are simple integer comparisons.  The frame rate that a
+ *  time was given in is kept only so that it can be written out in the same way.
+ *
+ *  A time without a frame rate is held as its seconds plus a number of ticks equal to its
+ *  frames.  Such times compare correctly with each other, but cannot be converted to
+ *  seconds, milliseconds or frames.  Comparing one with a time that has a rate throws
+ *  UnknownFrameRateError if they are in the same second, as the answer then depends on
+ *  the unknown rate.
+ */
 class Time
 {
 public:
 	Time ()
-		: _seconds (0)
-		, _frames (0)
+		: _ticks (0)
 	{}
 
+	static int64_t const ticks_per_second = 705600000;
+
 	int hours () const;
 	int minutes () const;
 	int seconds () const;
@@ -42,12 +58,21 @@ public:
 
 	double all_as_seconds () const;
 
+	int64_t ticks () const {
+		return _ticks;
+	}
+
+	boost::optional<Rational> rate () const {
+		return _rate;
+	}
+
 	void add (Time t);
 	void scale (float f);
 
 	static Time from_hmsf (int h, int m, int s, int f, boost::optional<Rational> rate = boost::optional<Rational> ());
 	static Time from_hms (int h, int m, int s, int ms);
 	static Time from_frames (int frames, Rational rate);
+	static Time from_ticks (int64_t ticks, boost::optional<Rational> rate = boost::optional<Rational> ());
 
 private:
 	friend bool operator< (Time const & a, Time const & b);
@@ -55,21 +80,55 @@ private:
 	friend bool operator== (Time const & a, Time const & b);
 	friend std::ostream& operator<< (std::ostream& s, Time const & t);
 
-	Time (int seconds, int frames, boost::optional<Rational> rate)
-		: _seconds (seconds)
-		, _frames (frames)
+	/** @return true if a and b are both with or both without a rate, so that their ticks can be compared */
+	static bool comparable (Time const & a, Time const & b) {
+		return a._rate.is_initialized() == b._rate.is_initialized();
+	}
+	static void check_mixed (Time const & a, Time const & b);
+
+	Time (int64_t ticks, boost::optional<Rational> rate)
+		: _ticks (ticks)
 		, _rate (rate)
 	{}
 
-	int _seconds;
-	int _frames;
+	int64_t _ticks;
+	/** frame rate that this time was specified in, if any */
 	boost::optional<Rational> _rate;
 };
 
-bool operator< (Time const & a, Time const & b);
-bool operator> (Time const & a, Time const & b);
-bool operator== (Time const & a, Time const & b);
-bool operator!= (Time const & a, Time const & b);
+inline bool
+operator< (Time const & a, Time const & b)
+{
+	if (!Time::comparable(a, b)) {
+		Time::check_mixed (a, b);
+	}
+	return a._ticks < b._ticks;
+}
+
+inline bool
+operator> (Time const & a, Time const & b)
+{
+	if (!Time::comparable(a, b)) {
+		Time::check_mixed (a, b);
+	}
+	return a._ticks > b._ticks;
+}
+
+inline bool
+operator== (Time const & a, Time const & b)
+{
+	if (!Time::comparable(a, b)) {
+		Time::check_mixed (a, b);
+	}
+	return a._ticks == b._ticks;
+}
+
+inline bool
+operator!= (Time const & a, Time const & b)
+{
+	return !(a == b);
+}
+
 std::ostream& operator<< (std::ostream& s, Time const & t);
 
 }
@@ -0,0 +1,49 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/subrip_push_parser.h
+ *  @brief SubripPushParser class.
+ */
+
+#ifndef LIBSUB_SUBRIP_PUSH_PARSER_H
+#define LIBSUB_SUBRIP_PUSH_PARSER_H
+
+#include "push_parser.h"
+#include "subrip_reader.h"
+
+namespace sub {
+
+/** @class SubripPushParser
+ *  @brief PushParser for SubRip, using the same parsing as SubripReader.
+ */
+class SubripPushParser : public PushParser
+{
+public:
+	explicit SubripPushParser (Handler handler);
+
+private:
+	bool process_line (SourceLine const& line) override;
+	std::vector<RawSubtitle>& pending () override;
+
+	SubripReader _reader;
+};
+
+}
+
+#endif
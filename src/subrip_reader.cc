@@ -24,18 +24,22 @@
 
 #include "compose.hpp"
 #include "exceptions.h"
+#include "line_source.h"
 #include "raw_convert.h"
+#include "scan.h"
 #include "ssa_reader.h"
 #include "sub_assert.h"
 #include "subrip_reader.h"
+#include "time_parser.h"
 #include "util.h"
 #include <boost/algorithm/string.hpp>
-#include <boost/algorithm/string_regex.hpp>
-#include <boost/bind/bind.hpp>
-#include <boost/lexical_cast.hpp>
-#include <boost/regex.hpp>
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <iterator>
+#include <thread>
 #include <vector>
 
 
@@ -43,296 +47,682 @@ using std::string;
 using std::vector;
 using std::cout;
 using std::hex;
-using boost::lexical_cast;
 using boost::to_upper;
 using boost::optional;
-using boost::function;
 using boost::algorithm::replace_all;
 using namespace sub;
 
 /** @param s Subtitle string encoded in UTF-8 */
 SubripReader::SubripReader (string s)
 {
-	this->read (boost::bind(&get_line_string, &s));
+	MemoryLineSource source (s.data(), s.size());
+	_source = &source;
+	read_all ();
+	_source = nullptr;
 }
 
 /** @param f Subtitle file encoded in UTF-8 */
 SubripReader::SubripReader (FILE* f)
 {
-	this->read (boost::bind (&get_line_file, f));
+	FileLineSource source (f);
+	_source = &source;
+	read_all ();
+	_source = nullptr;
 }
 
-void
-SubripReader::read (function<optional<string> ()> get_line)
+/** Read everything from source.
+ *  @param source Source of lines of a subtitle file encoded in UTF-8.
+ *  @param diagnostics Sink for diagnostics about the input, or null.
+ *  @param error_policy What to do about cues which cannot be read.
+ */
+SubripReader::SubripReader (LineSource& source, std::shared_ptr<DiagnosticSink> diagnostics, ErrorPolicy error_policy)
+{
+	set_diagnostic_sink (diagnostics);
+	set_error_policy (error_policy);
+	_source = &source;
+	read_all ();
+	_source = nullptr;
+}
+
+/** Prepare to read source a cue at a time, using next().
+ *  @param source Source of lines of a subtitle file encoded in UTF-8.
+ */
+SubripReader::SubripReader (std::shared_ptr<LineSource> source)
+	: _owned_source (source)
+	, _source (source.get())
+{
+
+}
+
+size_t const SubripReader::minimum_chunk_size;
+
+/** Read a file, parsing pieces of it in parallel.  The subtitles, and any
+ *  SubripError that is thrown or diagnostics that are reported, are the same
+ *  as those from the other constructors.
+ *  @param file Subtitle file encoded in UTF-8.
+ *  @param threads Number of threads to use.
+ *  @param diagnostics Sink for diagnostics about the input, or null.
+ *  @param error_policy What to do about cues which cannot be read.
+ */
+SubripReader::SubripReader (boost::filesystem::path file, int threads, std::shared_ptr<DiagnosticSink> diagnostics, ErrorPolicy error_policy)
+{
+	set_diagnostic_sink (diagnostics);
+	set_error_policy (error_policy);
+
+	MappedLineSource source (file);
+
+	threads = std::max (threads, 1);
+	/* Make a few chunks per thread so that a slow chunk does not hold everything up */
+	size_t const target = std::max (source.size() / (threads * 4), minimum_chunk_size);
+	auto const points = split_points (source.data(), source.size(), target);
+
+	if (threads == 1 || points.size() <= 2) {
+		_source = &source;
+		read_all ();
+		_source = nullptr;
+		return;
+	}
+
+	vector<vector<RawSubtitle>> chunks (points.size() - 1);
+	std::atomic<size_t> next (0);
+	std::atomic<bool> failed (false);
+
+	auto work = [&]() {
+		for (size_t i = next++; i < chunks.size() && !failed; i = next++) {
+			try {
+				MemoryLineSource chunk (source.data() + points[i], points[i + 1] - points[i]);
+				auto chunk_diagnostics = std::make_shared<CollectingDiagnosticSink>();
+				SubripReader reader (chunk, chunk_diagnostics, error_policy);
+				if (!chunk_diagnostics->diagnostics().empty()) {
+					failed = true;
+				}
+				chunks[i] = std::move (reader._subs);
+			} catch (...) {
+				failed = true;
+			}
+		}
+	};
+
+	vector<std::thread> workers;
+	for (int i = 1; i < std::min(threads, static_cast<int>(chunks.size())); ++i) {
+		workers.push_back (std::thread(work));
+	}
+	work ();
+	for (auto& i: workers) {
+		i.join ();
+	}
+
+	if (failed) {
+		/* Line numbers and context in errors and diagnostics are relative to
+		   the whole file, so find the problems again by reading serially.
+		*/
+		_source = &source;
+		read_all ();
+		_source = nullptr;
+		return;
+	}
+
+	size_t total = 0;
+	for (auto const& i: chunks) {
+		total += i.size();
+	}
+	_subs.reserve (total);
+	for (auto& i: chunks) {
+		_subs.insert (_subs.end(), std::make_move_iterator(i.begin()), std::make_move_iterator(i.end()));
+	}
+}
+
+/** Find places where some SubRip can be split into pieces which can be parsed
+ *  separately.  A piece must start with a counter line which comes after a blank
+ *  line and before a time line; the parser's state at such a point does not
+ *  depend on anything that came before.
+ *  @param target_chunk_size Approximate size of each piece in bytes.
+ *  @return Offsets of the start of each piece, followed by size.
+ */
+vector<size_t>
+SubripReader::split_points (char const* data, size_t size, size_t target_chunk_size)
 {
-	enum {
-		COUNTER,
-		METADATA,
-		CONTENT
-	} state = COUNTER;
+	auto line_end = [data, size](size_t start) {
+		auto end = static_cast<char const*> (memchr(data + start, '\n', size - start));
+		return end ? static_cast<size_t>(end - data) : size;
+	};
+
+	auto blank = [data](size_t start, size_t end) {
+		return end == start || (end == start + 1 && data[start] == '\r');
+	};
 
+	auto counter = [data](size_t start, size_t end) {
+		while (end > start && (data[end - 1] == '\r' || data[end - 1] == ' ')) {
+			--end;
+		}
+		if (end == start) {
+			return false;
+		}
+		for (size_t i = start; i < end; ++i) {
+			if (data[i] < '0' || data[i] > '9') {
+				return false;
+			}
+		}
+		return true;
+	};
 
-	auto prepare = [](RawSubtitle& rs) {
-		rs.vertical_position.line = 0;
-		rs.vertical_position.reference = TOP_OF_SUBTITLE;
+	auto times = [data](size_t start, size_t end) {
+		return std::search(data + start, data + end, "-->", "-->" + 3) != data + end;
 	};
 
-	RawSubtitle rs;
-	prepare(rs);
-	int line_number = 0;
+	/* Find a place to split at or after position, or return size if there isn't one */
+	auto find = [&](size_t position) {
+		/* Start of the line after the one containing position */
+		size_t line = line_end (position) + 1;
+		while (line < size) {
+			size_t const end = line_end (line);
+			if (blank(line, end) && end < size) {
+				size_t const counter_end = line_end (end + 1);
+				if (counter(end + 1, counter_end) && counter_end < size && times(counter_end + 1, line_end(counter_end + 1))) {
+					return end + 1;
+				}
+			}
+			line = end + 1;
+		}
+		return size;
+	};
 
-	while (true) {
-		auto line = get_line ();
-		++line_number;
-		if (!line) {
+	vector<size_t> points = { 0 };
+	size_t position = target_chunk_size;
+	while (position < size) {
+		auto const split = find (position);
+		if (split >= size) {
 			break;
 		}
+		points.push_back (split);
+		position = split + target_chunk_size;
+	}
+	points.push_back (size);
+	return points;
+}
+
+void
+SubripReader::prepare (RawSubtitle& rs)
+{
+	rs.vertical_position.line = 0;
+	rs.vertical_position.reference = TOP_OF_SUBTITLE;
+}
 
-		trim_right_if (*line, boost::is_any_of ("\n\r"));
-		remove_unicode_bom (line);
+bool
+SubripReader::read_more ()
+{
+	if (!_source) {
+		return false;
+	}
 
-		/* Keep some history in case there is an error to report */
-		_context.push_back (*line);
-		if (_context.size() > 5) {
-			_context.pop_front ();
+	SourceLine line;
+	while (_source->get(line)) {
+		if (process_line(line)) {
+			return true;
 		}
+	}
 
-		switch (state) {
-		case COUNTER:
-		{
-			if (line->empty ()) {
-				/* a blank line at the start is ok */
-				break;
-			}
+	return false;
+}
+
+/** Parse one line of input, adding any subtitles that it contains to _subs.
+ *  @return true if this line finished a cue.
+ */
+bool
+SubripReader::process_line (SourceLine const& source_line)
+{
+	/* Note where this line is in case there is an error to report */
+	_history.add (source_line, !_source);
+
+	auto line = source_line.string();
+	trim_right_if (line, boost::is_any_of ("\r"));
+	remove_unicode_bom (line);
+
+	if (_error_policy == ErrorPolicy::THROW) {
+		return parse_line (source_line.number, line);
+	}
+
+	try {
+		return parse_line (source_line.number, line);
+	} catch (SubripError& e) {
+		skipped_cue (source_line.number, source_line.offset, e.what());
+	} catch (SSAError& e) {
+		skipped_cue (source_line.number, source_line.offset, e.what());
+	}
+
+	/* Remove anything that the cue has already given, including text before the error on this line */
+	drop_cue ();
+
+	_state = State::SKIP;
+	return false;
+}
 
-			state = METADATA;
-			rs = RawSubtitle{};
-			prepare(rs);
+/** Parse one line of input, with any trailing \r and byte order mark removed.
+ *  @return true if this line finished a cue.
+ */
+bool
+SubripReader::parse_line (int line_number, string& line)
+{
+	switch (_state) {
+	case State::COUNTER:
+	{
+		if (line.empty ()) {
+			/* a blank line at the start is ok */
+			break;
 		}
-		break;
-		case METADATA:
-		{
-			vector<string> p;
-
-			/* Further trim this line, removing spaces from the end */
-			trim_right_if (*line, boost::is_any_of (" "));
-
-			boost::algorithm::split (p, *line, boost::algorithm::is_any_of (" "), boost::token_compress_on);
-			if (p.size() != 3 && p.size() != 7) {
-				for (int i = 0; i < 2; ++i) {
-					optional<string> ex = get_line ();
-					if (ex) {
-						_context.push_back (*ex);
-					}
+
+		_state = State::METADATA;
+		_rs = RawSubtitle{};
+		prepare(_rs);
+		start_cue ();
+	}
+	break;
+	case State::METADATA:
+	{
+		vector<string> p;
+
+		/* Further trim this line, removing spaces from the end */
+		trim_right_if (line, boost::is_any_of (" "));
+
+		boost::algorithm::split (p, line, boost::algorithm::is_any_of (" "), boost::token_compress_on);
+		if (p.size() != 3 && p.size() != 7) {
+			auto context = this->context();
+			for (int i = 0; _source && _error_policy == ErrorPolicy::THROW && i < 2; ++i) {
+				SourceLine ex;
+				if (_source->get(ex)) {
+					context.push_back (ex.string());
 				}
-				throw SubripError(line_number, *line, "a time/position line", _context);
 			}
+			throw SubripError(line_number, line, "a time/position line", context);
+		}
 
-			string expected;
-			auto from = convert_time(p[0], ",", &expected);
-			if (!from) {
-				throw SubripError(line_number, p[0], expected, _context);
-			}
-			rs.from = *from;
+		auto const from = parse_time<SubripTimeFormat>(p[0]);
+		if (!from) {
+			throw SubripError(line_number, p[0], time_parse_expected<SubripTimeFormat>(from.error), context());
+		}
+		_rs.from = from.time;
 
-			auto to = convert_time(p[2], ",", &expected);
-			if (!to) {
-				throw SubripError(line_number, p[2], expected, _context);
-			}
-			rs.to = *to;
+		auto const to = parse_time<SubripTimeFormat>(p[2]);
+		if (!to) {
+			throw SubripError(line_number, p[2], time_parse_expected<SubripTimeFormat>(to.error), context());
+		}
+		_rs.to = to.time;
 
-			/* XXX: should not ignore coordinate specifications */
+		/* XXX: should not ignore coordinate specifications */
 
-			state = CONTENT;
-			break;
-		}
-		case CONTENT:
-			if (line->empty ()) {
-				state = COUNTER;
-			} else {
-				vector<string> sub_lines;
-				/* Split up this line on unicode "LINE SEPARATOR".  This feels hacky but also
-				 * the least unpleasant place to do it.
-				 */
-				boost::algorithm::split_regex(sub_lines, *line, boost::regex("\xe2\x80\xa8"));
-				for (auto sub_line: sub_lines) {
-					convert_line(line_number, sub_line, rs);
-					rs.vertical_position.line = rs.vertical_position.line.get() + 1;
-					rs.text.clear();
+		_state = State::CONTENT;
+		break;
+	}
+	case State::CONTENT:
+		if (line.empty ()) {
+			_state = State::COUNTER;
+			return true;
+		} else {
+			/* Split up this line on unicode "LINE SEPARATOR".  This feels hacky but also
+			 * the least unpleasant place to do it.
+			 */
+			auto start = line.data();
+			auto const end = line.data() + line.size();
+			while (true) {
+				auto const separator = find_line_separator(start, end);
+				convert_line(line_number, start, separator - start, _rs);
+				_rs.vertical_position.line = _rs.vertical_position.line.get() + 1;
+				_rs.text.clear();
+				if (separator == end) {
+					break;
 				}
+				start = separator + line_separator_size;
 			}
-			break;
 		}
+		break;
+	case State::SKIP:
+		if (line.empty ()) {
+			_state = State::COUNTER;
+			return true;
+		} else if (line.find("-->") != string::npos) {
+			/* This looks like the time line of a cue which did not have a blank line before it */
+			_state = State::METADATA;
+			_rs = RawSubtitle{};
+			prepare(_rs);
+			start_cue ();
+			return parse_line (line_number, line);
+		}
+		break;
 	}
+
+	return false;
 }
 
+/** Parse a SubRip or WebVTT time.
+ *  @param milliseconds_separator "," for SubRip or "." for WebVTT.
+ *  @param expected If non-null, filled in with a description of what was expected if the time could not be parsed.
+ */
 optional<Time>
 SubripReader::convert_time(string t, string milliseconds_separator, string* expected)
 {
-	auto report_expected = [expected](string const& s) {
+	SUB_ASSERT(milliseconds_separator == "," || milliseconds_separator == ".");
+
+	auto const result = milliseconds_separator == "," ? parse_time<SubripTimeFormat>(t) : parse_time<WebVTTTimeFormat>(t);
+	if (!result) {
 		if (expected) {
-			*expected = s;
+			*expected = milliseconds_separator == "," ?
+				time_parse_expected<SubripTimeFormat>(result.error) :
+				time_parse_expected<WebVTTTimeFormat>(result.error);
 		}
-	};
-
-	vector<string> a;
-	boost::algorithm::split (a, t, boost::is_any_of (":"));
-	if (a.size() != 3) {
-		report_expected("time in the format h:m:s,ms");
 		return {};
 	}
 
-	vector<string> b;
-	boost::algorithm::split(b, a[2], boost::is_any_of(milliseconds_separator));
-	if (b.size() != 2) {
-		report_expected(String::compose("time in the format h:m:s%1ms", milliseconds_separator));
-		return {};
-	}
+	return result.time;
+}
 
-	int h, m, s, ms;
+namespace {
+
+enum class Tag {
+	BOLD_ON,
+	BOLD_OFF,
+	ITALIC_ON,
+	ITALIC_OFF,
+	UNDERLINE_ON,
+	UNDERLINE_OFF,
+	FONT_ON,
+	FONT_OFF,
+	SSA
+};
+
+/** A tag that can appear in SubRip text, written in lower case */
+struct TagName
+{
+	char const* name;
+	size_t size;
+	Tag tag;
+};
+
+/** Tags, in the order that they should be tried, for each character which can start one */
+TagName const angle_tags[] = {
+	{ "<b>", 3, Tag::BOLD_ON },
+	{ "</b>", 4, Tag::BOLD_OFF },
+	{ "<i>", 3, Tag::ITALIC_ON },
+	{ "</i>", 4, Tag::ITALIC_OFF },
+	{ "<u>", 3, Tag::UNDERLINE_ON },
+	{ "</u>", 4, Tag::UNDERLINE_OFF },
+	{ "<font", 5, Tag::FONT_ON },
+	{ "</font>", 7, Tag::FONT_OFF },
+	{ nullptr, 0, Tag::SSA }
+};
+
+TagName const brace_tags[] = {
+	{ "{b}", 3, Tag::BOLD_ON },
+	{ "{/b}", 4, Tag::BOLD_OFF },
+	{ "{i}", 3, Tag::ITALIC_ON },
+	{ "{/i}", 4, Tag::ITALIC_OFF },
+	{ "{u}", 3, Tag::UNDERLINE_ON },
+	{ "{/u}", 4, Tag::UNDERLINE_OFF },
+	{ "{\\", 2, Tag::SSA },
+	{ nullptr, 0, Tag::SSA }
+};
+
+inline char
+ascii_lower(char c)
+{
+	return (c >= 'A' && c <= 'Z') ? (c - 'A' + 'a') : c;
+}
 
-	try {
-		h = lexical_cast<int>(a[0]);
-	} catch (boost::bad_lexical_cast &) {
-		report_expected("integer hour value");
-		return {};
+/** @return true if the text starting at t matches name, ignoring the case of ASCII letters */
+inline bool
+starts_with(char const* t, size_t size, TagName const& name)
+{
+	if (size < name.size) {
+		return false;
 	}
 
-	try {
-		m = lexical_cast<int>(a[1]);
-	} catch (boost::bad_lexical_cast &) {
-		report_expected("integer minute value");
-		return {};
+	for (size_t i = 0; i < name.size; ++i) {
+		if (ascii_lower(t[i]) != name.name[i]) {
+			return false;
+		}
 	}
 
-	try {
-		s = lexical_cast<int>(b[0]);
-	} catch (boost::bad_lexical_cast &) {
-		report_expected("integer second value");
-		return {};
+	return true;
+}
+
+inline bool
+is_hex_digit(char c)
+{
+	return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+inline bool
+is_digit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+inline bool
+is_space(char c)
+{
+	return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+/** Find the hex digits of the last `color=#xxx' (with the # optionally quoted) in a tag.
+ *  @return true if one was found, in which case hex and hex_size are set.
+ */
+bool
+find_hex_colour(char const* tag, size_t size, char const*& hex, size_t& hex_size)
+{
+	static char const key[] = "color=";
+	size_t const key_size = sizeof(key) - 1;
+
+	for (size_t k = size >= key_size ? size - key_size + 1 : 0; k > 0; --k) {
+		size_t i = k - 1;
+		if (memcmp(tag + i, key, key_size) != 0) {
+			continue;
+		}
+		i += key_size;
+		if (i < size && (tag[i] == '"' || tag[i] == '\'')) {
+			++i;
+		}
+		if (i >= size || tag[i] != '#') {
+			continue;
+		}
+		++i;
+		size_t const start = i;
+		while (i < size && is_hex_digit(tag[i])) {
+			++i;
+		}
+		if (i > start) {
+			hex = tag + start;
+			hex_size = i - start;
+			return true;
+		}
 	}
 
-	try {
-		ms = lexical_cast<int>(b[1]);
-	} catch (boost::bad_lexical_cast &) {
-		report_expected("integer millisecond value");
-		return {};
+	return false;
+}
+
+/** Find the components of the last `color="rgba(r, g, b, a)"' in a tag.
+ *  @return true if one was found, in which case rgb is filled in with r, g and b.
+ */
+bool
+find_rgba_colour(char const* tag, size_t size, int rgb[3])
+{
+	static char const key[] = "color=\"rgba(";
+	size_t const key_size = sizeof(key) - 1;
+
+	for (size_t k = size >= key_size ? size - key_size + 1 : 0; k > 0; --k) {
+		size_t i = k - 1;
+		if (memcmp(tag + i, key, key_size) != 0) {
+			continue;
+		}
+		i += key_size;
+
+		bool ok = true;
+		for (int component = 0; ok && component < 4; ++component) {
+			while (i < size && is_space(tag[i])) {
+				++i;
+			}
+			size_t const start = i;
+			while (i < size && is_digit(tag[i])) {
+				++i;
+			}
+			if (i == start) {
+				ok = false;
+				break;
+			}
+			if (component < 3) {
+				rgb[component] = raw_convert<int>(string(tag + start, i - start));
+			}
+			while (i < size && is_space(tag[i])) {
+				++i;
+			}
+			if (component < 3) {
+				ok = i < size && tag[i] == ',';
+			} else {
+				ok = i + 1 < size && tag[i] == ')' && tag[i + 1] == '"';
+			}
+			++i;
+		}
+
+		if (ok) {
+			return true;
+		}
 	}
 
-	return Time::from_hms (h, m, s, ms);
+	return false;
+}
+
+}
+
+/** Handle the attributes of a <font> tag.
+ *  @param tag The tag, after `<font' and without the closing `>'.
+ */
+void
+SubripReader::convert_font_tag(int line_number, char const* tag, size_t size, RawSubtitle& p, vector<Colour>& colours)
+{
+	char const* hex;
+	size_t hex_size;
+	int rgb[3];
+
+	if (find_hex_colour(tag, size, hex, hex_size)) {
+		if (hex_size == 6) {
+			p.colour = Colour::from_rgb_hex(string(hex, hex_size));
+			colours.push_back(p.colour);
+		} else if (hex_size == 8) {
+			p.colour = Colour::from_rgba_hex(string(hex, hex_size));
+			colours.push_back(p.colour);
+		} else {
+			throw SubripError(line_number, string(tag, size), "a colour in the format #rrggbb #rrggbbaa or rgba(rr,gg,bb,aa)", context());
+		}
+	} else if (find_rgba_colour(tag, size, rgb)) {
+		p.colour.r = rgb[0] / 255.0;
+		p.colour.g = rgb[1] / 255.0;
+		p.colour.b = rgb[2] / 255.0;
+		colours.push_back(p.colour);
+	} else {
+		throw SubripError(line_number, string(tag, size), "a colour in the format #rrggbb #rrggbbaa or rgba(rr,gg,bb,aa)", context());
+	}
 }
 
+/** Convert a line of SubRip text, with its tags, into subtitles.  Each byte is looked at once:
+ *  runs of text are copied as they are, and only '<' and '{' are checked to see if they start a tag.
+ */
 void
-SubripReader::convert_line(int line_number, string t, RawSubtitle& p)
+SubripReader::convert_line(int line_number, char const* t, size_t size, RawSubtitle& p)
 {
 	vector<Colour> colours;
 	colours.push_back (Colour (1, 1, 1));
 
-	auto has_next = [](string line, size_t& index, string s) {
-		boost::to_lower(s);
-		auto next = line.substr(index, s.size());
-		boost::to_lower(next);
-		if (next != s) {
-			return false;
+	size_t i = 0;
+	while (i < size) {
+		/* Copy text up to the next character which might start a tag */
+		static ByteSet const tag_start("<{");
+		size_t const run = find_first_of(t + i, t + size, tag_start) - t;
+		if (run > i) {
+			p.text.append(t + i, run - i);
+			i = run;
+			continue;
 		}
 
-		index += s.size();
-		return true;
-	};
+		auto name = t[i] == '<' ? angle_tags : brace_tags;
+		while (name->name && !starts_with(t + i, size - i, *name)) {
+			++name;
+		}
 
-	size_t i = 0;
-	while (i < t.size()) {
-		if (has_next(t, i, "<b>") || has_next(t, i, "{b}")) {
+		if (!name->name) {
+			p.text += t[i];
+			++i;
+			continue;
+		}
+
+		i += name->size;
+
+		switch (name->tag) {
+		case Tag::BOLD_ON:
 			maybe_content (p);
 			p.bold = true;
-		} else if (has_next(t, i, "</b>") || has_next(t, i, "{/b}")) {
+			break;
+		case Tag::BOLD_OFF:
 			maybe_content (p);
 			p.bold = false;
-		} else if (has_next(t, i, "<i>") || has_next(t, i, "{i}")) {
+			break;
+		case Tag::ITALIC_ON:
 			maybe_content (p);
 			p.italic = true;
-		} else if (has_next(t, i, "</i>") || has_next(t, i, "{/i}")) {
+			break;
+		case Tag::ITALIC_OFF:
 			maybe_content (p);
 			p.italic = false;
-		} else if (has_next(t, i, "<u>") || has_next(t, i, "{u}")) {
+			break;
+		case Tag::UNDERLINE_ON:
 			maybe_content (p);
 			p.underline = true;
-		} else if (has_next(t, i, "</u>") || has_next(t, i, "{/u}")) {
+			break;
+		case Tag::UNDERLINE_OFF:
 			maybe_content (p);
 			p.underline = false;
-		} else if (has_next(t, i, "<font") || has_next(t, i, "<Font")) {
+			break;
+		case Tag::FONT_ON:
+		{
 			maybe_content (p);
-			boost::regex re (".*color=[\"\']?#([[:xdigit:]]+)[\"\']?");
-			boost::smatch match;
-			string tag;
-			while (i < t.size() && t[i] != '>') {
-				tag += t[i];
-				++i;
-			}
-			++i;
-			if (boost::regex_search(tag, match, re)) {
-				if (string(match[1]).size() == 6) {
-					p.colour = Colour::from_rgb_hex(match[1]);
-					colours.push_back(p.colour);
-				} else if (string(match[1]).size() == 8) {
-					p.colour = Colour::from_rgba_hex(match[1]);
-					colours.push_back(p.colour);
-				} else {
-					throw SubripError(line_number, tag, "a colour in the format #rrggbb #rrggbbaa or rgba(rr,gg,bb,aa)", _context);
-				}
-			} else {
-				re = boost::regex (
-					".*color=\"rgba\\("
-					"[[:space:]]*([[:digit:]]+)[[:space:]]*,"
-					"[[:space:]]*([[:digit:]]+)[[:space:]]*,"
-					"[[:space:]]*([[:digit:]]+)[[:space:]]*,"
-					"[[:space:]]*([[:digit:]]+)[[:space:]]*"
-					"\\)\""
-					);
-				if (boost::regex_search (tag, match, re) && match.size() == 5) {
-					p.colour.r = raw_convert<int>(string(match[1])) / 255.0;
-					p.colour.g = raw_convert<int>(string(match[2])) / 255.0;
-					p.colour.b = raw_convert<int>(string(match[3])) / 255.0;
-					colours.push_back (p.colour);
-				} else {
-					throw SubripError(line_number, tag, "a colour in the format #rrggbb #rrggbbaa or rgba(rr,gg,bb,aa)", _context);
-				}
-			}
-		} else if (has_next(t, i, "</font>")) {
+			auto end = static_cast<char const*>(memchr(t + i, '>', size - i));
+			size_t const tag_size = end ? (end - (t + i)) : (size - i);
+			convert_font_tag(line_number, t + i, tag_size, p, colours);
+			i += tag_size + 1;
+			break;
+		}
+		case Tag::FONT_OFF:
 			maybe_content (p);
 			/* Maybe there were no colours, or this is an extra unmatched </font> */
-			if (!colours.empty()) {
+			if (colours.size() > 1) {
 				colours.pop_back();
-				p.colour = colours.back();
-			}
-		} else if (has_next(t, i, "{\\")) {
-			string ssa = "\\";
-			while (i < t.size() && t[i] != '}') {
-				ssa += t[i];
-				++i;
 			}
-			++i;
-			SSAReader::parse_tag(p, ssa, SSAReader::Context{288, 288, Colour(1, 1, 1)});
-		} else {
-			p.text += t[i];
-			++i;
+			p.colour = colours.back();
+			break;
+		case Tag::SSA:
+		{
+			auto end = static_cast<char const*>(memchr(t + i, '}', size - i));
+			size_t const tag_size = end ? (end - (t + i)) : (size - i);
+			SSAReader::parse_tag(p, "\\" + string(t + i, tag_size), SSAReader::Context{288, 288, Colour(1, 1, 1)});
+			i += tag_size + 1;
+			break;
+		}
 		}
 	}
 
 	/* Strip Unicode U+202B (right-to-left embedding) as sometimes it is rendered
 	   as a missing character.  This may be a hack.
 	*/
-	replace_all (p.text, "\xe2\x80\xab", "");
+	if (p.text.find("\xe2\x80\xab") != string::npos) {
+		replace_all (p.text, "\xe2\x80\xab", "");
+	}
 
 	maybe_content (p);
 }
 
-/* Push p into _subs if it has some text, and clear the text out of p */
+/* Add p to our subtitles if it has some text, and clear the text out of p */
 void
 SubripReader::maybe_content (RawSubtitle& p)
 {
 	if (!p.text.empty ()) {
-		_subs.push_back (p);
+		add (p);
 		p.text.clear ();
 	}
 }
@@ -24,22 +24,40 @@
 #ifndef LIBSUB_SUBRIP_READER_H
 #define LIBSUB_SUBRIP_READER_H
 
+#include "line_source.h"
 #include "reader.h"
-#include <boost/function.hpp>
+#include <boost/filesystem.hpp>
 #include <list>
+#include <memory>
 
 struct subrip_reader_convert_line_test;
 struct subrip_reader_convert_time_test;
 struct subrip_reader_test5;
 struct subrip_reader_test6;
+struct subrip_reader_split_points_test;
 
 namespace sub {
 
+class LineSource;
+class SourceLine;
+
 class SubripReader : public Reader
 {
 public:
 	SubripReader (FILE* f);
 	SubripReader (std::string subs);
+	explicit SubripReader (
+		LineSource& source,
+		std::shared_ptr<DiagnosticSink> diagnostics = std::shared_ptr<DiagnosticSink>(),
+		ErrorPolicy error_policy = ErrorPolicy::THROW
+		);
+	explicit SubripReader (std::shared_ptr<LineSource> source);
+	SubripReader (
+		boost::filesystem::path file,
+		int threads,
+		std::shared_ptr<DiagnosticSink> diagnostics = std::shared_ptr<DiagnosticSink>(),
+		ErrorPolicy error_policy = ErrorPolicy::THROW
+		);
 
 	static boost::optional<Time> convert_time(std::string t, std::string milliseconds_separator, std::string* expected = nullptr);
 
@@ -49,13 +67,43 @@ private:
 	friend struct ::subrip_reader_convert_time_test;
 	friend struct ::subrip_reader_test5;
 	friend struct ::subrip_reader_test6;
+	friend struct ::subrip_reader_split_points_test;
+	friend class SubripPushParser;
 	SubripReader () {}
 
-	void convert_line(int line_number, std::string t, RawSubtitle& p);
+	/** smallest piece of input that is worth giving to a thread of its own */
+	static size_t const minimum_chunk_size = 64 * 1024;
+	static std::vector<size_t> split_points (char const* data, size_t size, size_t target_chunk_size);
+
+	bool read_more () override;
+	bool process_line (SourceLine const& line);
+	bool parse_line (int line_number, std::string& line);
+	std::list<std::string> context () const {
+		return _history.get (_source);
+	}
+	void convert_line(int line_number, char const* t, size_t size, RawSubtitle& p);
+	void convert_line(int line_number, std::string const& t, RawSubtitle& p) {
+		convert_line(line_number, t.data(), t.size(), p);
+	}
+	void convert_font_tag(int line_number, char const* tag, size_t size, RawSubtitle& p, std::vector<Colour>& colours);
 	void maybe_content (RawSubtitle& p);
-	void read (boost::function<boost::optional<std::string> ()> get_line);
+	static void prepare (RawSubtitle& rs);
+
+	std::shared_ptr<LineSource> _owned_source;
+	LineSource* _source = nullptr;
+
+	enum class State {
+		COUNTER,
+		METADATA,
+		CONTENT,
+		/** skipping the rest of a cue which had an error */
+		SKIP
+	} _state = State::COUNTER;
+
+	/** subtitle which is being built up from the current cue */
+	RawSubtitle _rs;
 
-	std::list<std::string> _context;
+	LineHistory _history;
 };
 
 }
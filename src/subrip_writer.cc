@@ -0,0 +1,287 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/subrip_writer.cc
+ *  @brief Writer for SubRip files.
+ */
+
+#include "subrip_writer.h"
+#include "subtitle.h"
+#include "time_formatter.h"
+#include <algorithm>
+#include <cmath>
+
+using std::string;
+using std::vector;
+using namespace sub;
+
+namespace {
+
+/** A style tag which may be open in the output */
+struct Tag
+{
+	/** in the order that they are opened, outermost first */
+	enum Kind {
+		FONT,
+		BOLD,
+		ITALIC,
+		UNDERLINE
+	};
+
+	Tag (Kind kind_, Colour colour_ = Colour())
+		: kind (kind_)
+		, colour (colour_)
+	{}
+
+	bool operator== (Tag const& other) const {
+		return kind == other.kind && (kind != FONT || colour == other.colour);
+	}
+
+	Kind kind;
+	Colour colour;
+};
+
+void
+append_int (string& out, int64_t n)
+{
+	char digits[20];
+	int size = 0;
+	do {
+		digits[size++] = '0' + n % 10;
+		n /= 10;
+	} while (n > 0);
+	while (size > 0) {
+		out += digits[--size];
+	}
+}
+
+void
+append_hex (string& out, float value)
+{
+	static char const hex[] = "0123456789abcdef";
+	int const v = std::max (0L, std::min (255L, std::lround(value * 255)));
+	out += hex[v >> 4];
+	out += hex[v & 0xf];
+}
+
+void
+append_open (string& out, Tag const& tag)
+{
+	switch (tag.kind) {
+	case Tag::FONT:
+		out += "<font color=\"#";
+		append_hex (out, tag.colour.r);
+		append_hex (out, tag.colour.g);
+		append_hex (out, tag.colour.b);
+		out += "\">";
+		break;
+	case Tag::BOLD:
+		out += "<b>";
+		break;
+	case Tag::ITALIC:
+		out += "<i>";
+		break;
+	case Tag::UNDERLINE:
+		out += "<u>";
+		break;
+	}
+}
+
+void
+append_close (string& out, Tag const& tag)
+{
+	switch (tag.kind) {
+	case Tag::FONT:
+		out += "</font>";
+		break;
+	case Tag::BOLD:
+		out += "</b>";
+		break;
+	case Tag::ITALIC:
+		out += "</i>";
+		break;
+	case Tag::UNDERLINE:
+		out += "</u>";
+		break;
+	}
+}
+
+/** @return the N of the {\anN} tag for a line's position, or 0 if it is in the default position */
+int
+alignment (Line const& line)
+{
+	int column = 2;
+	switch (line.horizontal_position.reference) {
+	case LEFT_OF_SCREEN:
+		column = 1;
+		break;
+	case HORIZONTAL_CENTRE_OF_SCREEN:
+		column = 2;
+		break;
+	case RIGHT_OF_SCREEN:
+		column = 3;
+		break;
+	}
+
+	auto const reference = line.vertical_position.reference.get_value_or(TOP_OF_SUBTITLE);
+	switch (reference) {
+	case BOTTOM_OF_SCREEN:
+		return column;
+	case VERTICAL_CENTRE_OF_SCREEN:
+		return column + 3;
+	case TOP_OF_SCREEN:
+		return column + 6;
+	case TOP_OF_SUBTITLE:
+		break;
+	}
+
+	return column == 2 ? 0 : column;
+}
+
+/** Append the text of a subtitle, given that it has at least one line with some text */
+void
+append_text (string& out, Subtitle const& subtitle)
+{
+	/* Tags which are open, outermost first */
+	vector<Tag> open;
+	vector<Tag> wanted;
+	int current_alignment = 0;
+	bool first = true;
+
+	for (auto const& line: subtitle.lines) {
+		auto const has_text = std::any_of(line.blocks.begin(), line.blocks.end(), [](Block const& b) { return !b.text.empty(); });
+		if (!has_text) {
+			/* An empty line would end the subtitle */
+			continue;
+		}
+
+		bool start_of_line = true;
+		for (auto const& block: line.blocks) {
+			if (block.text.empty()) {
+				continue;
+			}
+
+			wanted.clear ();
+			if (!(block.colour == Colour(1, 1, 1))) {
+				wanted.push_back (Tag(Tag::FONT, block.colour));
+			}
+			if (block.bold) {
+				wanted.push_back (Tag::BOLD);
+			}
+			if (block.italic) {
+				wanted.push_back (Tag::ITALIC);
+			}
+			if (block.underline) {
+				wanted.push_back (Tag::UNDERLINE);
+			}
+
+			/* Keep the outermost tags that are still wanted, close the rest and then
+			   open whatever is missing, so that tags are always properly nested.
+			*/
+			size_t keep = 0;
+			while (keep < open.size() && std::find(wanted.begin(), wanted.end(), open[keep]) != wanted.end()) {
+				++keep;
+			}
+			while (open.size() > keep) {
+				append_close (out, open.back());
+				open.pop_back ();
+			}
+
+			/* Start the line after closing tags, so that they are closed on the line where the style ends */
+			if (start_of_line) {
+				if (!first) {
+					out += '\n';
+				}
+				first = false;
+				start_of_line = false;
+
+				auto const line_alignment = alignment (line);
+				if (line_alignment != 0 && line_alignment != current_alignment) {
+					out += "{\\an";
+					out += '0' + line_alignment;
+					out += '}';
+					current_alignment = line_alignment;
+				}
+			}
+
+			for (auto const& i: wanted) {
+				if (std::find(open.begin(), open.end(), i) == open.end()) {
+					append_open (out, i);
+					open.push_back (i);
+				}
+			}
+
+			out += block.text;
+		}
+	}
+
+	while (!open.empty()) {
+		append_close (out, open.back());
+		open.pop_back ();
+	}
+}
+
+}
+
+void
+sub::format_subrip (vector<Subtitle> const& subtitles, string& out)
+{
+	/* Guess how much we will write, so that out is only allocated once */
+	size_t size = 0;
+	for (auto const& i: subtitles) {
+		size += 48;
+		for (auto const& j: i.lines) {
+			size += 1;
+			for (auto const& k: j.blocks) {
+				size += k.text.size() + 8;
+			}
+		}
+	}
+	out.reserve (out.size() + size);
+
+	int64_t index = 1;
+	for (auto const& i: subtitles) {
+		auto const has_text = std::any_of(i.lines.begin(), i.lines.end(), [](Line const& line) {
+			return std::any_of(line.blocks.begin(), line.blocks.end(), [](Block const& b) { return !b.text.empty(); });
+		});
+		if (!has_text) {
+			continue;
+		}
+
+		if (index > 1) {
+			out += '\n';
+		}
+		append_int (out, index++);
+		out += '\n';
+		format_time<SubripTimeFormat> (i.from, out);
+		out += " --> ";
+		format_time<SubripTimeFormat> (i.to, out);
+		out += '\n';
+		append_text (out, i);
+		out += '\n';
+	}
+}
+
+void
+sub::write_subrip (vector<Subtitle> const& subtitles, std::ostream& out)
+{
+	string buffer;
+	format_subrip (subtitles, buffer);
+	out.write (buffer.data(), buffer.size());
+}
@@ -0,0 +1,48 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/subrip_writer.h
+ *  @brief Writer for SubRip files.
+ */
+
+#ifndef LIBSUB_SUBRIP_WRITER_H
+#define LIBSUB_SUBRIP_WRITER_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace sub {
+
+class Subtitle;
+
+/** Format some subtitles as SubRip, appending to a string.
+ *  Bold, italic, underline and colour are written as <b>, <i>, <u> and <font color> tags, which
+ *  are only closed and opened where the style changes (so a style may continue from one line
+ *  of a subtitle to the next).  Subtitles which are not in the default position are given a
+ *  {\\anN} tag.
+ */
+extern void format_subrip (std::vector<Subtitle> const& subtitles, std::string& out);
+
+/** Write some subtitles as SubRip with a single write to a stream; see format_subrip() */
+extern void write_subrip (std::vector<Subtitle> const& subtitles, std::ostream& out);
+
+}
+
+#endif
@@ -21,35 +21,51 @@
 
 using namespace sub;
 
-Subtitle::Subtitle (RawSubtitle s)
+Subtitle::Subtitle (RawSubtitle const& s)
 	: from (s.from)
 	, to (s.to)
 	, fade_up (s.fade_up)
 	, fade_down (s.fade_down)
 {
-	lines.push_back (Line (s));
+	lines.emplace_back (s);
+}
+
+Subtitle::Subtitle (RawSubtitle&& s)
+	: from (s.from)
+	, to (s.to)
+	, fade_up (s.fade_up)
+	, fade_down (s.fade_down)
+{
+	lines.emplace_back (std::move(s));
 }
 
 bool
-Subtitle::same_metadata (RawSubtitle s) const
+Subtitle::same_metadata (RawSubtitle const& s) const
 {
 	return from == s.from && to == s.to && fade_up == s.fade_up && fade_down == s.fade_down;
 }
 
-Line::Line (RawSubtitle s)
+Line::Line (RawSubtitle const& s)
+	: horizontal_position (s.horizontal_position)
+	, vertical_position (s.vertical_position)
+{
+	blocks.emplace_back (s);
+}
+
+Line::Line (RawSubtitle&& s)
 	: horizontal_position (s.horizontal_position)
 	, vertical_position (s.vertical_position)
 {
-	blocks.push_back (Block (s));
+	blocks.emplace_back (std::move(s));
 }
 
 bool
-Line::same_metadata (RawSubtitle s) const
+Line::same_metadata (RawSubtitle const& s) const
 {
 	return vertical_position == s.vertical_position;
 }
 
-Block::Block (RawSubtitle s)
+Block::Block (RawSubtitle const& s)
 	: text (s.text)
 	, font (s.font)
 	, font_size (s.font_size)
@@ -63,6 +79,20 @@ Block::Block (RawSubtitle s)
 
 }
 
+Block::Block (RawSubtitle&& s)
+	: text (std::move(s.text))
+	, font (std::move(s.font))
+	, font_size (s.font_size)
+	, effect (s.effect)
+	, effect_colour (s.effect_colour)
+	, colour (s.colour)
+	, bold (s.bold)
+	, italic (s.italic)
+	, underline (s.underline)
+{
+
+}
+
 bool
 sub::operator== (Subtitle const & a, Subtitle const & b)
 {
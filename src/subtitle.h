@@ -37,6 +37,10 @@ namespace sub {
  *  @brief A block of text within a subtitle's line
  *
  *  This represents a block of text which has a particular style (font, size, effect, colour etc.)
+ *
+ *  A Block holds its own copy of its style rather than an id from a StyleTable, so comparing
+ *  two Blocks compares each field of their styles.  Fragments within a RawSubtitleTrack can
+ *  instead be compared by RawSubtitleTrack::style_id().
  */
 class Block
 {
@@ -49,7 +53,9 @@ public:
 	{}
 
 	/** Construct a Block taking any relevant information from a RawSubtitle */
-	Block (RawSubtitle s);
+	Block (RawSubtitle const& s);
+	/** Construct a Block taking any relevant information from a RawSubtitle, moving its text and font */
+	Block (RawSubtitle&& s);
 
 	/** Subtitle text in UTF-8 */
 	std::string text;
@@ -83,7 +89,8 @@ public:
 	}
 
 	/** Construct a Line taking any relevant information from a RawSubtitle */
-	Line (RawSubtitle s);
+	Line (RawSubtitle const& s);
+	Line (RawSubtitle&& s);
 
 	HorizontalPosition horizontal_position;
 
@@ -92,7 +99,7 @@ public:
 
 	std::vector<Block> blocks;
 
-	bool same_metadata (RawSubtitle) const;
+	bool same_metadata (RawSubtitle const &) const;
 };
 
 extern bool operator== (Line const & a, Line const & b);
@@ -109,8 +116,9 @@ public:
 	Subtitle ()
 	{}
 
-	/** Construct a Line taking any relevant information from a RawSubtitle */
-	Subtitle (RawSubtitle s);
+	/** Construct a Subtitle taking any relevant information from a RawSubtitle */
+	Subtitle (RawSubtitle const& s);
+	Subtitle (RawSubtitle&& s);
 
 	/** from time */
 	Time from;
@@ -122,7 +130,7 @@ public:
 
 	std::vector<Line> lines;
 
-	bool same_metadata (RawSubtitle) const;
+	bool same_metadata (RawSubtitle const &) const;
 };
 
 extern bool operator== (Subtitle const & a, Subtitle const & b);
@@ -0,0 +1,140 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/subtitle_index.cc
+ *  @brief SubtitleIndex class.
+ */
+
+#include "subtitle_index.h"
+#include <algorithm>
+
+using std::vector;
+using namespace sub;
+
+SubtitleIndex::SubtitleIndex (vector<Subtitle> subtitles)
+	: _subtitles (std::move(subtitles))
+{
+	std::stable_sort (_subtitles.begin(), _subtitles.end(), [](Subtitle const& a, Subtitle const& b) { return a.from < b.from; });
+
+	if (!_subtitles.empty()) {
+		_latest.resize (_subtitles.size() * 4);
+		build (1, 0, _subtitles.size());
+	}
+}
+
+void
+SubtitleIndex::build (size_t node, size_t begin, size_t end)
+{
+	if (end - begin == 1) {
+		_latest[node] = _subtitles[begin].to;
+		return;
+	}
+
+	auto const middle = begin + (end - begin) / 2;
+	build (node * 2, begin, middle);
+	build (node * 2 + 1, middle, end);
+	_latest[node] = std::max (_latest[node * 2], _latest[node * 2 + 1]);
+}
+
+/** Find the subtitles in [begin, end) with index less than limit and which end after a time,
+ *  adding their indices to out in ascending order.
+ */
+void
+SubtitleIndex::find (size_t node, size_t begin, size_t end, size_t limit, Time const& after, vector<size_t>& out) const
+{
+	if (begin >= limit || !(_latest[node] > after)) {
+		return;
+	}
+
+	if (end - begin == 1) {
+		out.push_back (begin);
+		return;
+	}
+
+	auto const middle = begin + (end - begin) / 2;
+	find (node * 2, begin, middle, limit, after, out);
+	find (node * 2 + 1, middle, end, limit, after, out);
+}
+
+/** @return indices of the subtitles which are on screen at t, in ascending order */
+vector<size_t>
+SubtitleIndex::at (Time t) const
+{
+	vector<size_t> out;
+	if (_subtitles.empty()) {
+		return out;
+	}
+
+	/* Subtitles before limit start at or before t */
+	auto const limit = std::upper_bound (
+		_subtitles.begin(), _subtitles.end(), t, [](Time const& t, Subtitle const& s) { return t < s.from; }
+		) - _subtitles.begin();
+
+	find (1, 0, _subtitles.size(), limit, t, out);
+	return out;
+}
+
+/** @return indices of the subtitles which are on screen at any time from `from' up to but not including `to', in ascending order */
+vector<size_t>
+SubtitleIndex::between (Time from, Time to) const
+{
+	vector<size_t> out;
+	if (_subtitles.empty()) {
+		return out;
+	}
+
+	/* Subtitles before limit start before to */
+	auto const limit = std::lower_bound (
+		_subtitles.begin(), _subtitles.end(), to, [](Subtitle const& s, Time const& t) { return s.from < t; }
+		) - _subtitles.begin();
+
+	find (1, 0, _subtitles.size(), limit, from, out);
+	return out;
+}
+
+/** Move the playback position to t.  This is quick if t is a little later than the last
+ *  call; going backwards, or jumping far ahead, costs the same as at().
+ *  @return indices of the subtitles which are on screen at t, in ascending order.
+ */
+vector<size_t> const&
+SubtitleIndex::advance (Time t)
+{
+	auto const limit = _subtitles.size();
+
+	if (_position && !(t < *_position) && (_next == limit || !(_subtitles[_next].to < t))) {
+		/* Move forwards from where we were */
+		auto end = std::remove_if (_active.begin(), _active.end(), [this, &t](size_t i) { return !(_subtitles[i].to > t); });
+		_active.erase (end, _active.end());
+		while (_next < limit && !(t < _subtitles[_next].from)) {
+			if (_subtitles[_next].to > t) {
+				_active.push_back (_next);
+			}
+			++_next;
+		}
+	} else {
+		/* Seek */
+		_active = at (t);
+		_next = std::upper_bound (
+			_subtitles.begin(), _subtitles.end(), t, [](Time const& t, Subtitle const& s) { return t < s.from; }
+			) - _subtitles.begin();
+	}
+
+	_position = t;
+	return _active;
+}
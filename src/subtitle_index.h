@@ -0,0 +1,85 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/subtitle_index.h
+ *  @brief SubtitleIndex class.
+ */
+
+#ifndef LIBSUB_SUBTITLE_INDEX_H
+#define LIBSUB_SUBTITLE_INDEX_H
+
+#include "subtitle.h"
+#include <boost/optional.hpp>
+#include <vector>
+
+namespace sub {
+
+/** @class SubtitleIndex
+ *  @brief An index of some Subtitles to find which are on screen at a given time.
+ *
+ *  A subtitle is on screen from its from time up to, but not including, its to time.
+ *  The subtitles are kept sorted by from time and each node of a segment tree over them
+ *  records the latest to time underneath it, so queries take O(log n + k) for k results
+ *  rather than a scan of every subtitle.  For playback, advance() keeps track of what is on
+ *  screen as time moves forward, at a cost proportional to what changes.
+ */
+class SubtitleIndex
+{
+public:
+	explicit SubtitleIndex (std::vector<Subtitle> subtitles);
+
+	/** @return the subtitles, sorted by from time; indices returned by other methods refer to this */
+	std::vector<Subtitle> const& subtitles () const {
+		return _subtitles;
+	}
+
+	Subtitle const& operator[] (size_t i) const {
+		return _subtitles[i];
+	}
+
+	size_t size () const {
+		return _subtitles.size ();
+	}
+
+	std::vector<size_t> at (Time t) const;
+	std::vector<size_t> between (Time from, Time to) const;
+
+	std::vector<size_t> const& advance (Time t);
+
+private:
+	void build (size_t node, size_t begin, size_t end);
+	void find (size_t node, size_t begin, size_t end, size_t limit, Time const& after, std::vector<size_t>& out) const;
+
+	std::vector<Subtitle> _subtitles;
+	/** latest to time of the subtitles under each node of the tree; node 1 is the root and
+	 *  node n has children 2n and 2n + 1.
+	 */
+	std::vector<Time> _latest;
+
+	/** time last given to advance() */
+	boost::optional<Time> _position;
+	/** index of the first subtitle that starts after _position */
+	size_t _next = 0;
+	/** indices of the subtitles that are on screen at _position, in ascending order */
+	std::vector<size_t> _active;
+};
+
+}
+
+#endif
@@ -0,0 +1,155 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/thread_pool.cc
+ *  @brief ThreadPool class.
+ */
+
+#include "thread_pool.h"
+#include <algorithm>
+
+using std::function;
+using std::unique_lock;
+using std::mutex;
+using std::vector;
+using boost::optional;
+using namespace sub;
+
+ThreadPool::ThreadPool (int threads)
+{
+	if (threads <= 0) {
+		threads = std::max (1U, std::thread::hardware_concurrency());
+	}
+
+	for (int i = 0; i < threads; ++i) {
+		_queues.push_back (std::unique_ptr<Queue>(new Queue));
+	}
+
+	for (int i = 0; i < threads; ++i) {
+		_threads.push_back (std::thread(&ThreadPool::thread, this, i));
+	}
+}
+
+ThreadPool::~ThreadPool ()
+{
+	{
+		unique_lock<mutex> lm (_mutex);
+		_stop = true;
+	}
+	_work_condition.notify_all ();
+
+	for (auto& i: _threads) {
+		i.join ();
+	}
+}
+
+void
+ThreadPool::run (vector<function<void ()>> tasks)
+{
+	unique_lock<mutex> run_lock (_run_mutex);
+
+	if (tasks.empty()) {
+		return;
+	}
+
+	{
+		/* Hold _mutex so that no thread can account for a task before we have counted them all */
+		unique_lock<mutex> lm (_mutex);
+		_remaining = tasks.size();
+		_queued = tasks.size();
+		_error = nullptr;
+
+		/* Deal the tasks out between the threads' queues */
+		for (size_t i = 0; i < tasks.size(); ++i) {
+			auto& queue = *_queues[i % _queues.size()];
+			unique_lock<mutex> qm (queue.mutex);
+			queue.tasks.push_back (std::move(tasks[i]));
+		}
+	}
+
+	_work_condition.notify_all ();
+
+	unique_lock<mutex> lm (_mutex);
+	_done_condition.wait (lm, [this]() { return _remaining == 0; });
+
+	if (_error) {
+		std::rethrow_exception (_error);
+	}
+}
+
+/** Take a task from the front of our own queue or, failing that, from the back of someone else's */
+optional<function<void ()>>
+ThreadPool::take (size_t index)
+{
+	for (size_t i = 0; i < _queues.size(); ++i) {
+		auto& queue = *_queues[(index + i) % _queues.size()];
+		unique_lock<mutex> lm (queue.mutex);
+		if (queue.tasks.empty()) {
+			continue;
+		}
+
+		function<void ()> task;
+		if (i == 0) {
+			task = std::move (queue.tasks.front());
+			queue.tasks.pop_front ();
+		} else {
+			task = std::move (queue.tasks.back());
+			queue.tasks.pop_back ();
+		}
+		return task;
+	}
+
+	return {};
+}
+
+void
+ThreadPool::thread (size_t index)
+{
+	while (true) {
+		{
+			unique_lock<mutex> lm (_mutex);
+			_work_condition.wait (lm, [this]() { return _stop || _queued > 0; });
+			if (_stop) {
+				return;
+			}
+		}
+
+		while (auto task = take(index)) {
+			{
+				unique_lock<mutex> lm (_mutex);
+				--_queued;
+			}
+
+			std::exception_ptr error;
+			try {
+				(*task) ();
+			} catch (...) {
+				error = std::current_exception ();
+			}
+
+			unique_lock<mutex> lm (_mutex);
+			if (error && !_error) {
+				_error = error;
+			}
+			if (--_remaining == 0) {
+				_done_condition.notify_all ();
+			}
+		}
+	}
+}
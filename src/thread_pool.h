@@ -0,0 +1,92 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/thread_pool.h
+ *  @brief ThreadPool class.
+ */
+
+#ifndef LIBSUB_THREAD_POOL_H
+#define LIBSUB_THREAD_POOL_H
+
+#include "executor.h"
+#include <boost/optional.hpp>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace sub {
+
+/** @class ThreadPool
+ *  @brief Executor which runs tasks on a fixed set of threads.
+ *
+ *  Each thread has its own queue of tasks, and a thread whose queue is empty
+ *  will take tasks from the other end of another thread's queue.  This keeps
+ *  every thread busy when some tasks take much longer than others.
+ */
+class ThreadPool : public Executor
+{
+public:
+	/** @param threads Number of threads, or 0 to use one per hardware thread */
+	explicit ThreadPool (int threads = 0);
+	~ThreadPool ();
+
+	ThreadPool (ThreadPool const&) = delete;
+	ThreadPool& operator= (ThreadPool const&) = delete;
+
+	void run (std::vector<std::function<void ()>> tasks) override;
+
+	int threads () const {
+		return static_cast<int>(_threads.size());
+	}
+
+private:
+	class Queue
+	{
+	public:
+		std::mutex mutex;
+		std::deque<std::function<void ()>> tasks;
+	};
+
+	void thread (size_t index);
+	boost::optional<std::function<void ()>> take (size_t index);
+
+	std::vector<std::unique_ptr<Queue>> _queues;
+	std::vector<std::thread> _threads;
+
+	/** one run() at a time */
+	std::mutex _run_mutex;
+
+	/** protects the following */
+	std::mutex _mutex;
+	std::condition_variable _work_condition;
+	std::condition_variable _done_condition;
+	/** number of tasks from the current run() which have not yet finished */
+	size_t _remaining = 0;
+	/** number of tasks which have been queued but not yet taken */
+	size_t _queued = 0;
+	std::exception_ptr _error;
+	bool _stop = false;
+};
+
+}
+
+#endif
@@ -0,0 +1,101 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/time_formatter.h
+ *  @brief format_time(), the counterpart of parse_time().
+ */
+
+#ifndef LIBSUB_TIME_FORMATTER_H
+#define LIBSUB_TIME_FORMATTER_H
+
+#include "exceptions.h"
+#include "sub_time.h"
+#include "time_parser.h"
+#include <string>
+
+namespace sub {
+
+/** Enough space for any timestamp written by format_time() */
+int const format_time_max_size = 32;
+
+/** Write a timestamp as hh:mm:ss then the Format's fraction separator and milliseconds,
+ *  rounding to the nearest millisecond.  Hours have at least two digits; negative times
+ *  are written as zero.  This does not allocate.  A time without a frame rate cannot be
+ *  converted to milliseconds, so it gives UnknownFrameRateError.
+ *  @tparam Format Format of the timestamp, e.g. SubripTimeFormat; its fraction must be milliseconds.
+ *  @param out Somewhere to write, with space for at least format_time_max_size bytes.
+ *  @return pointer to the byte after the last one written.
+ */
+template <class Format>
+char*
+format_time (Time t, char* out)
+{
+	static_assert (Format::fraction_milliseconds == 1, "format_time() can only write milliseconds");
+
+	if (!t.rate()) {
+		throw UnknownFrameRateError ();
+	}
+
+	int64_t const ticks_per_millisecond = Time::ticks_per_second / 1000;
+	int64_t const all = t.ticks() > 0 ? (t.ticks() + ticks_per_millisecond / 2) / ticks_per_millisecond : 0;
+
+	int64_t const ms = all % 1000;
+	int64_t const s = all / 1000 % 60;
+	int64_t const m = all / 60000 % 60;
+	int64_t h = all / 3600000;
+
+	/* Hours, which may need more than two digits */
+	char digits[20];
+	int n = 0;
+	do {
+		digits[n++] = '0' + h % 10;
+		h /= 10;
+	} while (h > 0);
+	if (n < 2) {
+		digits[n++] = '0';
+	}
+	while (n > 0) {
+		*out++ = digits[--n];
+	}
+
+	*out++ = ':';
+	*out++ = '0' + m / 10;
+	*out++ = '0' + m % 10;
+	*out++ = ':';
+	*out++ = '0' + s / 10;
+	*out++ = '0' + s % 10;
+	*out++ = Format::fraction_separator;
+	*out++ = '0' + ms / 100;
+	*out++ = '0' + ms / 10 % 10;
+	*out++ = '0' + ms % 10;
+	return out;
+}
+
+/** Append a timestamp to a string; see format_time(Time, char*) */
+template <class Format>
+void
+format_time (Time t, std::string& out)
+{
+	char buffer[format_time_max_size];
+	out.append (buffer, format_time<Format>(t, buffer));
+}
+
+}
+
+#endif
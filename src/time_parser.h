@@ -0,0 +1,244 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/time_parser.h
+ *  @brief parse_time() and the timestamp formats that it understands.
+ */
+
+#ifndef LIBSUB_TIME_PARSER_H
+#define LIBSUB_TIME_PARSER_H
+
+#include "sub_time.h"
+#include <climits>
+#include <cstddef>
+#include <string>
+
+namespace sub {
+
+/** Something that went wrong when parsing a timestamp */
+enum class TimeParseError
+{
+	NONE,
+	/** the separators were missing, misplaced or repeated */
+	FORMAT,
+	HOURS,
+	MINUTES,
+	SECONDS,
+	/** the milliseconds, centiseconds or frames */
+	FRACTION
+};
+
+/** @class TimeParseResult
+ *  @brief The result of parse_time(): a time, or where parsing failed.
+ */
+class TimeParseResult
+{
+public:
+	TimeParseResult (Time t)
+		: time (t)
+	{}
+
+	TimeParseResult (TimeParseError e)
+		: error (e)
+	{}
+
+	explicit operator bool () const {
+		return error == TimeParseError::NONE;
+	}
+
+	Time time;
+	TimeParseError error = TimeParseError::NONE;
+};
+
+/* Formats for parse_time().  Each gives the separator between seconds and the
+ * fraction, how many milliseconds each unit of the fraction is (or 0 if the
+ * fraction is a count of frames), and some descriptions for error messages.
+ */
+
+/** hh:mm:ss,mmm */
+struct SubripTimeFormat
+{
+	static char const fraction_separator = ',';
+	static int const fraction_milliseconds = 1;
+	static char const* description () { return "h:m:s,ms"; }
+	static char const* fraction_name () { return "millisecond"; }
+};
+
+/** hh:mm:ss.mmm */
+struct WebVTTTimeFormat
+{
+	static char const fraction_separator = '.';
+	static int const fraction_milliseconds = 1;
+	static char const* description () { return "h:m:s.ms"; }
+	static char const* fraction_name () { return "millisecond"; }
+};
+
+/** h:mm:ss.cc */
+struct SSATimeFormat
+{
+	static char const fraction_separator = '.';
+	static int const fraction_milliseconds = 10;
+	static char const* description () { return "h:mm:ss.cc"; }
+	static char const* fraction_name () { return "centisecond"; }
+};
+
+/** hh:mm:ss:ff, with no particular frame rate */
+struct STLTextTimeFormat
+{
+	static char const fraction_separator = ':';
+	static int const fraction_milliseconds = 0;
+	static char const* description () { return "hh:mm:ss:ff"; }
+	static char const* fraction_name () { return "frame"; }
+};
+
+namespace time_parser {
+
+/** Parse an integer which is all of [begin, end): an optional sign then at least one digit.
+ *  @return false if the text is not such an integer, or it does not fit in an int.
+ */
+inline bool
+parse_int (char const* begin, char const* end, int& value)
+{
+	bool negative = false;
+	if (begin < end && (*begin == '-' || *begin == '+')) {
+		negative = *begin == '-';
+		++begin;
+	}
+
+	if (begin == end) {
+		return false;
+	}
+
+	int64_t v = 0;
+	for (auto p = begin; p < end; ++p) {
+		unsigned int const digit = static_cast<unsigned char>(*p) - '0';
+		if (digit > 9) {
+			return false;
+		}
+		v = v * 10 + digit;
+		if (v > int64_t(INT_MAX) + 1) {
+			return false;
+		}
+	}
+
+	if (negative) {
+		v = -v;
+	}
+	if (v > INT_MAX) {
+		return false;
+	}
+
+	value = static_cast<int>(v);
+	return true;
+}
+
+inline char const*
+find (char const* begin, char const* end, char c)
+{
+	while (begin < end && *begin != c) {
+		++begin;
+	}
+	return begin;
+}
+
+}
+
+/** Parse a timestamp from [begin, end), which must contain nothing else.  This does not
+ *  allocate or throw.  Each field may have any number of digits, and a sign.
+ *  @tparam Format Format of the timestamp, e.g. SubripTimeFormat.
+ */
+template <class Format>
+TimeParseResult
+parse_time (char const* begin, char const* end)
+{
+	using time_parser::find;
+	using time_parser::parse_int;
+
+	auto const first_colon = find (begin, end, ':');
+	if (first_colon == end) {
+		return TimeParseError::FORMAT;
+	}
+	auto const second_colon = find (first_colon + 1, end, ':');
+	if (second_colon == end) {
+		return TimeParseError::FORMAT;
+	}
+
+	/* The rest must have exactly one fraction separator and no other colons */
+	auto const fraction_separator = find (second_colon + 1, end, Format::fraction_separator);
+	if (fraction_separator == end || find(fraction_separator + 1, end, Format::fraction_separator) != end) {
+		return TimeParseError::FORMAT;
+	}
+	if (Format::fraction_separator != ':' && find(second_colon + 1, end, ':') != end) {
+		return TimeParseError::FORMAT;
+	}
+
+	int h, m, s, f;
+	if (!parse_int(begin, first_colon, h)) {
+		return TimeParseError::HOURS;
+	}
+	if (!parse_int(first_colon + 1, second_colon, m)) {
+		return TimeParseError::MINUTES;
+	}
+	if (!parse_int(second_colon + 1, fraction_separator, s)) {
+		return TimeParseError::SECONDS;
+	}
+	if (!parse_int(fraction_separator + 1, end, f)) {
+		return TimeParseError::FRACTION;
+	}
+
+	if (Format::fraction_milliseconds == 0) {
+		return Time::from_hmsf (h, m, s, f);
+	}
+
+	return Time::from_hms (h, m, s, f * Format::fraction_milliseconds);
+}
+
+template <class Format>
+TimeParseResult
+parse_time (std::string const& t)
+{
+	return parse_time<Format> (t.data(), t.data() + t.size());
+}
+
+/** @return a description of what parse_time() expected to find when it gave a particular error */
+template <class Format>
+std::string
+time_parse_expected (TimeParseError error)
+{
+	switch (error) {
+	case TimeParseError::NONE:
+		break;
+	case TimeParseError::FORMAT:
+		return std::string("time in the format ") + Format::description();
+	case TimeParseError::HOURS:
+		return "integer hour value";
+	case TimeParseError::MINUTES:
+		return "integer minute value";
+	case TimeParseError::SECONDS:
+		return "integer second value";
+	case TimeParseError::FRACTION:
+		return std::string("integer ") + Format::fraction_name() + " value";
+	}
+
+	return "";
+}
+
+}
+
+#endif
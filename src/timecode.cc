@@ -0,0 +1,205 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/timecode.cc
+ *  @brief Timecode class, and conversions between frames and ticks.
+ */
+
+#include "exceptions.h"
+#include "sub_assert.h"
+#include "timecode.h"
+#include <iomanip>
+
+using std::ostream;
+using std::setfill;
+using std::setw;
+using namespace sub;
+
+/** @return true if rate is n/d */
+static bool
+is (Rational rate, int n, int d)
+{
+	return int64_t(rate.numerator) * d == int64_t(rate.denominator) * n;
+}
+
+/** @return the number of ticks in some frames at a given rate, rounded to the nearest tick */
+int64_t
+sub::frames_to_ticks (int64_t frames, Rational rate)
+{
+	SUB_ASSERT (rate.numerator > 0);
+	SUB_ASSERT (rate.denominator > 0);
+
+	if (is(rate, 24, 1)) {
+		return FixedFrameRate<24, 1>::frames_to_ticks (frames);
+	} else if (is(rate, 25, 1)) {
+		return FixedFrameRate<25, 1>::frames_to_ticks (frames);
+	} else if (is(rate, 30, 1)) {
+		return FixedFrameRate<30, 1>::frames_to_ticks (frames);
+	} else if (is(rate, 1000, 1)) {
+		return FixedFrameRate<1000, 1>::frames_to_ticks (frames);
+	} else if (is(rate, 24000, 1001)) {
+		return FixedFrameRate<24000, 1001>::frames_to_ticks (frames);
+	} else if (is(rate, 30000, 1001)) {
+		return FixedFrameRate<30000, 1001>::frames_to_ticks (frames);
+	} else if (is(rate, 60000, 1001)) {
+		return FixedFrameRate<60000, 1001>::frames_to_ticks (frames);
+	}
+
+	/* Split into whole seconds and a remainder to avoid overflow */
+	int64_t const scaled = frames * rate.denominator;
+	int64_t const seconds = scaled / rate.numerator;
+	int64_t const remainder = scaled % rate.numerator;
+	return seconds * Time::ticks_per_second + (remainder * Time::ticks_per_second + rate.numerator / 2) / rate.numerator;
+}
+
+/** @return the number of frames at a given rate in some ticks, rounded to the nearest frame */
+int64_t
+sub::ticks_to_frames (int64_t ticks, Rational rate)
+{
+	SUB_ASSERT (rate.numerator > 0);
+	SUB_ASSERT (rate.denominator > 0);
+
+	if (is(rate, 24, 1)) {
+		return FixedFrameRate<24, 1>::ticks_to_frames (ticks);
+	} else if (is(rate, 25, 1)) {
+		return FixedFrameRate<25, 1>::ticks_to_frames (ticks);
+	} else if (is(rate, 30, 1)) {
+		return FixedFrameRate<30, 1>::ticks_to_frames (ticks);
+	} else if (is(rate, 1000, 1)) {
+		return FixedFrameRate<1000, 1>::ticks_to_frames (ticks);
+	} else if (is(rate, 24000, 1001)) {
+		return FixedFrameRate<24000, 1001>::ticks_to_frames (ticks);
+	} else if (is(rate, 30000, 1001)) {
+		return FixedFrameRate<30000, 1001>::ticks_to_frames (ticks);
+	} else if (is(rate, 60000, 1001)) {
+		return FixedFrameRate<60000, 1001>::ticks_to_frames (ticks);
+	}
+
+	int64_t const seconds = ticks / Time::ticks_per_second;
+	int64_t const remainder = ticks % Time::ticks_per_second;
+	int64_t const scale = int64_t(rate.denominator) * Time::ticks_per_second;
+	return (seconds * rate.numerator) / rate.denominator
+		+ ((seconds * rate.numerator) % rate.denominator * Time::ticks_per_second + remainder * rate.numerator + scale / 2) / scale;
+}
+
+/** @return the number of frames that timecode counts in each second at a given rate,
+ *  e.g. 30 for 30000/1001.
+ */
+int
+sub::timecode_base (Rational rate)
+{
+	SUB_ASSERT (rate.numerator > 0);
+	SUB_ASSERT (rate.denominator > 0);
+	return (rate.numerator + rate.denominator - 1) / rate.denominator;
+}
+
+/** @return the number of frame numbers that drop-frame timecode skips at the start of a minute */
+static int
+dropped_frames (Rational rate)
+{
+	SUB_ASSERT (is(rate, 30000, 1001) || is(rate, 60000, 1001));
+	return timecode_base(rate) / 15;
+}
+
+/** @return the number of frames since 00:00:00:00 */
+int64_t
+Timecode::to_frames (Rational rate) const
+{
+	int64_t const base = timecode_base (rate);
+	int64_t const total_minutes = int64_t(hours) * 60 + minutes;
+	int64_t result = (total_minutes * 60 + seconds) * base + frames;
+
+	if (drop_frame) {
+		result -= dropped_frames(rate) * (total_minutes - total_minutes / 10);
+	}
+
+	return result;
+}
+
+Time
+Timecode::to_time (Rational rate) const
+{
+	return Time::from_ticks (frames_to_ticks(to_frames(rate), rate), rate);
+}
+
+/** @param frames Number of frames since 00:00:00:00, which must not be negative */
+Timecode
+Timecode::from_frames (int64_t frames, Rational rate, bool drop_frame)
+{
+	SUB_ASSERT (frames >= 0);
+
+	int64_t const base = timecode_base (rate);
+
+	if (drop_frame) {
+		int64_t const drop = dropped_frames (rate);
+		int64_t const per_minute = base * 60 - drop;
+		int64_t const per_ten_minutes = base * 600 - drop * 9;
+		int64_t const tens = frames / per_ten_minutes;
+		int64_t const within = frames % per_ten_minutes;
+		/* Add back the frame numbers that have been skipped */
+		frames += drop * 9 * tens;
+		if (within >= drop) {
+			frames += drop * ((within - drop) / per_minute);
+		}
+	}
+
+	Timecode t;
+	t.frames = frames % base;
+	t.seconds = (frames / base) % 60;
+	t.minutes = (frames / (base * 60)) % 60;
+	t.hours = frames / (base * 3600);
+	t.drop_frame = drop_frame;
+	return t;
+}
+
+/** @return the timecode of the frame nearest to time.  A time without a rate holds its frames
+ *  as a count of ticks, so it cannot be converted; UnknownFrameRateError is thrown for one.
+ */
+Timecode
+Timecode::from_time (Time time, Rational rate, bool drop_frame)
+{
+	if (!time.rate()) {
+		throw UnknownFrameRateError ();
+	}
+
+	return from_frames (ticks_to_frames(time.ticks(), rate), rate, drop_frame);
+}
+
+bool
+sub::operator== (Timecode const & a, Timecode const & b)
+{
+	return a.hours == b.hours && a.minutes == b.minutes && a.seconds == b.seconds && a.frames == b.frames && a.drop_frame == b.drop_frame;
+}
+
+bool
+sub::operator!= (Timecode const & a, Timecode const & b)
+{
+	return !(a == b);
+}
+
+/** Write a timecode in the usual way, with a ; before the frames if it is drop-frame */
+ostream&
+sub::operator<< (ostream& s, Timecode const & t)
+{
+	s << setw(2) << setfill('0') << t.hours << ":"
+	  << setw(2) << setfill('0') << t.minutes << ":"
+	  << setw(2) << setfill('0') << t.seconds << (t.drop_frame ? ";" : ":")
+	  << setw(2) << setfill('0') << t.frames;
+	return s;
+}
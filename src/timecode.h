@@ -0,0 +1,102 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/timecode.h
+ *  @brief Timecode and FixedFrameRate classes, and conversions between frames and ticks.
+ */
+
+#ifndef LIBSUB_TIMECODE_H
+#define LIBSUB_TIMECODE_H
+
+#include "sub_time.h"
+#include <cstdint>
+#include <iostream>
+
+namespace sub {
+
+/** @class FixedFrameRate
+ *  @brief Conversions between frames and ticks at a frame rate which is known at compile time,
+ *  so that they are a multiplication or a division by a constant.
+ */
+template <int Numerator, int Denominator>
+class FixedFrameRate
+{
+public:
+	static_assert ((Time::ticks_per_second * Denominator) % Numerator == 0, "a frame must be a whole number of ticks");
+
+	static constexpr int64_t ticks_per_frame = Time::ticks_per_second * Denominator / Numerator;
+
+	static int64_t frames_to_ticks (int64_t frames) {
+		return frames * ticks_per_frame;
+	}
+
+	/** @return number of frames in ticks, rounded to the nearest frame with halves rounded up */
+	static int64_t ticks_to_frames (int64_t ticks) {
+		auto const t = ticks + ticks_per_frame / 2;
+		return (t >= 0) ? (t / ticks_per_frame) : -((ticks_per_frame - 1 - t) / ticks_per_frame);
+	}
+};
+
+int64_t frames_to_ticks (int64_t frames, Rational rate);
+int64_t ticks_to_frames (int64_t ticks, Rational rate);
+int timecode_base (Rational rate);
+
+/** @class Timecode
+ *  @brief A SMPTE timecode, which labels a frame with hours, minutes, seconds and frames.
+ *
+ *  Timecode counts frames at the whole-number base rate, e.g. 24 for 24000/1001 or 30 for
+ *  30000/1001, so its hours, minutes and seconds drift from clock time at the NTSC rates.
+ *  In drop-frame timecode (30000/1001 and 60000/1001 only) the first 2 (or 4) frame numbers
+ *  of each minute, except every tenth minute, are skipped to keep it close to clock time.
+ *
+ *  This is different to Time::from_hmsf(), which takes h, m and s as clock time.
+ */
+class Timecode
+{
+public:
+	Timecode () {}
+
+	Timecode (int hours_, int minutes_, int seconds_, int frames_, bool drop_frame_ = false)
+		: hours (hours_)
+		, minutes (minutes_)
+		, seconds (seconds_)
+		, frames (frames_)
+		, drop_frame (drop_frame_)
+	{}
+
+	int hours = 0;
+	int minutes = 0;
+	int seconds = 0;
+	int frames = 0;
+	bool drop_frame = false;
+
+	int64_t to_frames (Rational rate) const;
+	Time to_time (Rational rate) const;
+
+	static Timecode from_frames (int64_t frames, Rational rate, bool drop_frame = false);
+	static Timecode from_time (Time time, Rational rate, bool drop_frame = false);
+};
+
+bool operator== (Timecode const & a, Timecode const & b);
+bool operator!= (Timecode const & a, Timecode const & b);
+std::ostream& operator<< (std::ostream& s, Timecode const & t);
+
+}
+
+#endif
@@ -32,9 +32,7 @@ namespace sub {
 class Reader;
 
 extern bool empty_or_white_space (std::string s);
-extern void remove_unicode_bom (boost::optional<std::string>& line);
-extern boost::optional<std::string> get_line_file (FILE* f);
-extern boost::optional<std::string> get_line_string (std::string* s);
+extern void remove_unicode_bom (std::string& line);
 extern void dump (std::shared_ptr<const Reader> read, std::ostream& os);
 
 }
@@ -0,0 +1,4 @@
+#include "version.h"
+char const * sub::git_commit = "8f99116642";
+char const * sub::version = "devel";
+bool const built_with_debug = false;
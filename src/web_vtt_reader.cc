@@ -19,18 +19,16 @@
 
 
 #include "exceptions.h"
-#include "subrip_reader.h"
+#include "line_source.h"
+#include "scan.h"
+#include "time_parser.h"
 #include "util.h"
 #include "web_vtt_reader.h"
 #include <boost/algorithm/string.hpp>
-#include <boost/algorithm/string_regex.hpp>
-#include <boost/bind/bind.hpp>
-#include <boost/regex.hpp>
 #include <iostream>
 #include <vector>
 
 
-using std::function;
 using std::string;
 using std::vector;
 using boost::optional;
@@ -39,117 +37,198 @@ using namespace sub;
 
 WebVTTReader::WebVTTReader(FILE* file)
 {
-	this->read(boost::bind(&get_line_file, file));
+	FileLineSource source(file);
+	_source = &source;
+	read_all();
+	_source = nullptr;
 }
 
 
 WebVTTReader::WebVTTReader(string subs)
 {
-	this->read(boost::bind(&get_line_string, &subs));
+	MemoryLineSource source(subs.data(), subs.size());
+	_source = &source;
+	read_all();
+	_source = nullptr;
 }
 
 
-void
-WebVTTReader::read(std::function<optional<string> ()> get_line)
+/** Read everything from source.
+ *  @param diagnostics Sink for diagnostics about the input, or null.
+ *  @param error_policy What to do about cues which cannot be read.
+ */
+WebVTTReader::WebVTTReader(LineSource& source, std::shared_ptr<DiagnosticSink> diagnostics, ErrorPolicy error_policy)
+{
+	set_diagnostic_sink(diagnostics);
+	set_error_policy(error_policy);
+	_source = &source;
+	read_all();
+	_source = nullptr;
+}
+
+
+/** Prepare to read source a cue at a time, using next() */
+WebVTTReader::WebVTTReader(std::shared_ptr<LineSource> source)
+	: _owned_source(source)
+	, _source(source.get())
 {
-	enum class State {
-		/* expecting WEBVTT */
-		HEADER,
-		/* awaiting a NOTE, some other metadata, or a subtitle timing line */
-		DATA,
-		/* reading the text of a subtitle */
-		SUBTITLE,
-		/* reading a note */
-		NOTE
-	} state = State::HEADER;
-
-	RawSubtitle rs;
-
-	rs.vertical_position.line = 0;
-	rs.vertical_position.reference = TOP_OF_SUBTITLE;
-
-	while (true) {
-		auto line = get_line();
-		if (!line) {
-			break;
-		}
 
-		trim_right_if(*line, boost::is_any_of("\n\r"));
-		remove_unicode_bom(line);
+}
+
+
+bool
+WebVTTReader::read_more()
+{
+	if (!_source) {
+		return false;
+	}
 
-		/* Keep some history in case there is an error to report */
-		_context.push_back(*line);
-		if (_context.size() > 5) {
-			_context.pop_front();
+	SourceLine line;
+	while (_source->get(line)) {
+		if (process_line(line)) {
+			return true;
 		}
+	}
+
+	return false;
+}
+
+
+/** Parse one line of input, adding any subtitles that it contains to _subs.
+ *  @return true if this line finished a cue.
+ */
+bool
+WebVTTReader::process_line(SourceLine const& source_line)
+{
+	/* Note where this line is in case there is an error to report */
+	_history.add(source_line, !_source);
+
+	auto line = source_line.string();
+	trim_right_if(line, boost::is_any_of("\r"));
+	remove_unicode_bom(line);
+
+	if (_error_policy == ErrorPolicy::THROW) {
+		return parse_line(line);
+	}
 
-		switch (state) {
-		case State::HEADER:
-			if (!boost::starts_with(*line, "WEBVTT")) {
-				throw WebVTTHeaderError();
+	try {
+		return parse_line(line);
+	} catch (WebVTTHeaderError&) {
+		throw;
+	} catch (WebVTTError& e) {
+		/* The rest of the cue will be ignored as we look for the next time line */
+		skipped_cue(source_line.number, source_line.offset, e.what());
+		drop_cue();
+		_state = State::DATA;
+	}
+
+	return false;
+}
+
+
+/** Parse one line of input, with any trailing \r and byte order mark removed.
+ *  @return true if this line finished a cue.
+ */
+bool
+WebVTTReader::parse_line(string& line)
+{
+	switch (_state) {
+	case State::HEADER:
+		if (!boost::starts_with(line, "WEBVTT")) {
+			throw WebVTTHeaderError();
+		}
+		_rs.vertical_position.line = 0;
+		_rs.vertical_position.reference = TOP_OF_SUBTITLE;
+		_state = State::HEADER_BLOCK;
+		break;
+	case State::HEADER_BLOCK:
+		if (line.empty()) {
+			_state = State::DATA;
+		} else if (line.find("-->") != string::npos) {
+			/* There should have been a blank line before this first cue */
+			_state = State::DATA;
+			return parse_line(line);
+		} else {
+			/* Lines like X-TIMESTAMP-MAP=... or Kind: captions */
+			auto const divider = line.find_first_of("=:");
+			if (divider != string::npos) {
+				auto key = line.substr(0, divider);
+				auto value = line.substr(divider + 1);
+				boost::algorithm::trim(key);
+				boost::algorithm::trim(value);
+				_metadata[key] = value;
 			}
-			state = State::DATA;
-			break;
-		case State::DATA:
-			if (boost::starts_with(*line, "NOTE")) {
-				state = State::NOTE;
-			} else if (line->find("-->") != string::npos) {
-				/* Further trim this line, removing spaces from the end */
-				trim_right_if(*line, boost::is_any_of(" "));
-
-				vector<string> parts;
-				boost::algorithm::split(parts, *line, boost::algorithm::is_any_of(" "), boost::token_compress_on);
-
-				if (parts.size() != 3 && parts.size() != 7) {
-					for (int i = 0; i < 2; ++i) {
-						auto ex = get_line();
-						if (ex) {
-							_context.push_back(*ex);
-						}
+		}
+		break;
+	case State::DATA:
+		if (boost::starts_with(line, "NOTE")) {
+			_state = State::NOTE;
+		} else if (line.find("-->") != string::npos) {
+			start_cue();
+
+			/* Further trim this line, removing spaces from the end */
+			trim_right_if(line, boost::is_any_of(" "));
+
+			vector<string> parts;
+			boost::algorithm::split(parts, line, boost::algorithm::is_any_of(" "), boost::token_compress_on);
+
+			/* There may be any number of cue settings after the times, which we ignore */
+			if (parts.size() < 3) {
+				auto context = this->context();
+				for (int i = 0; _source && _error_policy == ErrorPolicy::THROW && i < 2; ++i) {
+					SourceLine ex;
+					if (_source->get(ex)) {
+						context.push_back(ex.string());
 					}
-					throw WebVTTError(*line, "a time line", _context);
-				}
-
-				string expected;
-				auto from = SubripReader::convert_time(parts[0], ".", &expected);
-				if (!from) {
-					throw WebVTTError(parts[0], expected, _context);
 				}
-				rs.from = *from;
+				throw WebVTTError(line, "a time line", context);
+			}
 
-				auto to = SubripReader::convert_time(parts[2], ".", &expected);
-				if (!to) {
-					throw WebVTTError(parts[2], expected, _context);
-				}
-				rs.to = *to;
+			auto const from = parse_time<WebVTTTimeFormat>(parts[0]);
+			if (!from) {
+				throw WebVTTError(parts[0], time_parse_expected<WebVTTTimeFormat>(from.error), context());
+			}
+			_rs.from = from.time;
 
-				rs.vertical_position.line = 0;
-				state = State::SUBTITLE;
+			auto const to = parse_time<WebVTTTimeFormat>(parts[2]);
+			if (!to) {
+				throw WebVTTError(parts[2], time_parse_expected<WebVTTTimeFormat>(to.error), context());
 			}
-			break;
-		case State::SUBTITLE:
-			if (line->empty()) {
-				state = State::DATA;
-			} else {
-				/* Split up this line on unicode "LINE SEPARATOR".  This feels hacky but also
-				 * the least unpleasant place to do it.
-				 */
-				vector<string> sub_lines;
-				boost::algorithm::split_regex(sub_lines, *line, boost::regex("\xe2\x80\xa8"));
-				for (auto sub_line: sub_lines) {
-					rs.text = sub_line;
-					_subs.push_back(rs);
-					rs.vertical_position.line = rs.vertical_position.line.get() + 1;
+			_rs.to = to.time;
+
+			_rs.vertical_position.line = 0;
+			_state = State::SUBTITLE;
+		}
+		break;
+	case State::SUBTITLE:
+		if (line.empty()) {
+			_state = State::DATA;
+			return true;
+		} else {
+			/* Split up this line on unicode "LINE SEPARATOR".  This feels hacky but also
+			 * the least unpleasant place to do it.
+			 */
+			auto start = line.data();
+			auto const end = line.data() + line.size();
+			while (true) {
+				auto const separator = find_line_separator(start, end);
+				_rs.text.assign(start, separator);
+				add(_rs);
+				_rs.vertical_position.line = _rs.vertical_position.line.get() + 1;
+				if (separator == end) {
+					break;
 				}
+				start = separator + line_separator_size;
 			}
-			break;
-		case State::NOTE:
-			if (line->empty()) {
-				state = State::DATA;
-			}
-			break;
 		}
-
+		break;
+	case State::NOTE:
+		if (line.empty()) {
+			_state = State::DATA;
+		}
+		break;
 	}
+
+	return false;
 }
 
@@ -22,25 +22,73 @@
 #define LIBSUB_WEB_VTT_READER_H
 
 
+#include "line_source.h"
 #include "reader.h"
 #include <cstdio>
 #include <list>
+#include <map>
+#include <memory>
 #include <string>
 
 
 namespace sub {
 
 
+class LineSource;
+class SourceLine;
+
+
 class WebVTTReader : public Reader
 {
 public:
 	WebVTTReader(FILE* file);
 	WebVTTReader(std::string subs);
+	explicit WebVTTReader(
+		LineSource& source,
+		std::shared_ptr<DiagnosticSink> diagnostics = std::shared_ptr<DiagnosticSink>(),
+		ErrorPolicy error_policy = ErrorPolicy::THROW
+		);
+	explicit WebVTTReader(std::shared_ptr<LineSource> source);
+
+	/** @return the settings from the header, such as X-TIMESTAMP-MAP, which
+	 *  come after the WEBVTT line and before the first blank line.
+	 */
+	std::map<std::string, std::string> metadata() const override {
+		return _metadata;
+	}
 
 private:
-	void read(std::function<boost::optional<std::string> ()> get_line);
-
-	std::list<std::string> _context;
+	friend class WebVTTPushParser;
+	WebVTTReader() {}
+
+	bool read_more() override;
+	bool process_line(SourceLine const& line);
+	bool parse_line(std::string& line);
+	std::list<std::string> context() const {
+		return _history.get(_source);
+	}
+
+	std::shared_ptr<LineSource> _owned_source;
+	LineSource* _source = nullptr;
+
+	enum class State {
+		/* expecting WEBVTT */
+		HEADER,
+		/* reading the rest of the header, up to the first blank line */
+		HEADER_BLOCK,
+		/* awaiting a NOTE, some other metadata, or a subtitle timing line */
+		DATA,
+		/* reading the text of a subtitle */
+		SUBTITLE,
+		/* reading a note */
+		NOTE
+	} _state = State::HEADER;
+
+	/** subtitle which is being built up from the current cue */
+	RawSubtitle _rs;
+
+	LineHistory _history;
+	std::map<std::string, std::string> _metadata;
 };
 
 
@@ -0,0 +1,433 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/web_vtt_writer.cc
+ *  @brief Writers for WebVTT files and HLS WebVTT segments.
+ */
+
+#include "compose.hpp"
+#include "exceptions.h"
+#include "hls_web_vtt_reader.h"
+#include "scan.h"
+#include "sub_assert.h"
+#include "subtitle.h"
+#include "time_formatter.h"
+#include "web_vtt_writer.h"
+#include <algorithm>
+#include <cfloat>
+#include <cstdio>
+
+using std::string;
+using std::vector;
+using namespace sub;
+
+namespace {
+
+struct NamedColour
+{
+	char const* name;
+	float r;
+	float g;
+	float b;
+};
+
+/** WebVTT's default colour classes; white is first as it needs no markup */
+NamedColour const named_colours[] = {
+	{ "white", 1, 1, 1 },
+	{ "lime", 0, 1, 0 },
+	{ "cyan", 0, 1, 1 },
+	{ "red", 1, 0, 0 },
+	{ "yellow", 1, 1, 0 },
+	{ "magenta", 1, 0, 1 },
+	{ "blue", 0, 0, 1 },
+	{ "black", 0, 0, 0 }
+};
+
+/** @return the colour class closest to a colour, or nullptr for white */
+char const*
+colour_class (Colour const& colour)
+{
+	int best = 0;
+	float best_distance = FLT_MAX;
+	for (size_t i = 0; i < sizeof(named_colours) / sizeof(NamedColour); ++i) {
+		auto const& n = named_colours[i];
+		float const distance = (colour.r - n.r) * (colour.r - n.r) + (colour.g - n.g) * (colour.g - n.g) + (colour.b - n.b) * (colour.b - n.b);
+		if (distance < best_distance) {
+			best = i;
+			best_distance = distance;
+		}
+	}
+
+	return best == 0 ? nullptr : named_colours[best].name;
+}
+
+/* Style tags; these are compared by address, as are the colour class names */
+char const* const bold_tag = "b";
+char const* const italic_tag = "i";
+char const* const underline_tag = "u";
+
+bool
+is_colour_class (char const* tag)
+{
+	return tag != bold_tag && tag != italic_tag && tag != underline_tag;
+}
+
+void
+append_open_tag (string& out, char const* tag)
+{
+	out += is_colour_class(tag) ? "<c." : "<";
+	out += tag;
+	out += '>';
+}
+
+void
+append_close_tag (string& out, char const* tag)
+{
+	if (is_colour_class(tag)) {
+		out += "</c>";
+	} else {
+		out += "</";
+		out += tag;
+		out += '>';
+	}
+}
+
+void
+append_percentage (string& out, float proportion)
+{
+	char buffer[16];
+	int n = snprintf (buffer, sizeof(buffer), "%.2f", std::min(std::max(proportion * 100, 0.0f), 100.0f));
+	/* Remove any unnecessary zeros and decimal point */
+	while (buffer[n - 1] == '0') {
+		--n;
+	}
+	if (buffer[n - 1] == '.') {
+		--n;
+	}
+	out.append (buffer, n);
+	out += '%';
+}
+
+void
+append_escaped (string& out, string const& text)
+{
+	static ByteSet const special ("&<>");
+
+	auto p = text.data();
+	auto const end = p + text.size();
+	while (p < end) {
+		auto const next = find_first_of (p, end, special);
+		out.append (p, next);
+		if (next == end) {
+			break;
+		}
+		switch (*next) {
+		case '&':
+			out += "&amp;";
+			break;
+		case '<':
+			out += "&lt;";
+			break;
+		case '>':
+			out += "&gt;";
+			break;
+		}
+		p = next + 1;
+	}
+}
+
+/** Append cue settings for the position of a subtitle */
+void
+append_settings (string& out, Subtitle const& subtitle)
+{
+	/* The cue's line setting positions its first line, or its last if it is
+	   positioned from the bottom of the screen.
+	*/
+	auto const& first = subtitle.lines.front().vertical_position;
+	auto const& last = subtitle.lines.back().vertical_position;
+	auto const& vertical = (first.reference && first.reference.get() == BOTTOM_OF_SCREEN) ? last : first;
+
+	if (vertical.reference && vertical.reference.get() != TOP_OF_SUBTITLE) {
+		if (vertical.proportional || (vertical.line && vertical.lines)) {
+			out += " line:";
+			append_percentage (out, vertical.fraction_from_screen_top());
+			switch (vertical.reference.get()) {
+			case VERTICAL_CENTRE_OF_SCREEN:
+				out += ",center";
+				break;
+			case BOTTOM_OF_SCREEN:
+				out += ",end";
+				break;
+			default:
+				break;
+			}
+		} else if (vertical.line && vertical.reference.get() == TOP_OF_SCREEN) {
+			out += " line:" + std::to_string(vertical.line.get());
+		} else if (vertical.line && vertical.reference.get() == BOTTOM_OF_SCREEN) {
+			out += " line:" + std::to_string(-vertical.line.get() - 1);
+		}
+	}
+
+	auto const& horizontal = subtitle.lines.front().horizontal_position;
+	switch (horizontal.reference) {
+	case LEFT_OF_SCREEN:
+		out += " position:";
+		append_percentage (out, horizontal.proportional);
+		out += " align:left";
+		break;
+	case HORIZONTAL_CENTRE_OF_SCREEN:
+		if (horizontal.proportional != 0) {
+			out += " position:";
+			append_percentage (out, 0.5 + horizontal.proportional);
+		}
+		break;
+	case RIGHT_OF_SCREEN:
+		out += " position:";
+		append_percentage (out, 1 - horizontal.proportional);
+		out += " align:right";
+		break;
+	}
+}
+
+/** Append the text of a line with markup for its styles.  Tags are only closed and opened
+ *  where the style changes, keeping them properly nested.
+ */
+void
+append_line (string& out, Line const& line)
+{
+	/* Tags which are open, outermost first; each is a colour class or b, i or u */
+	vector<char const*> open;
+
+	for (auto const& block: line.blocks) {
+		if (block.text.empty()) {
+			continue;
+		}
+
+		char const* wanted[4];
+		int wanted_size = 0;
+		if (auto c = colour_class(block.colour)) {
+			wanted[wanted_size++] = c;
+		}
+		if (block.bold) {
+			wanted[wanted_size++] = bold_tag;
+		}
+		if (block.italic) {
+			wanted[wanted_size++] = italic_tag;
+		}
+		if (block.underline) {
+			wanted[wanted_size++] = underline_tag;
+		}
+
+		auto is_wanted = [&](char const* tag) {
+			return std::find(wanted, wanted + wanted_size, tag) != wanted + wanted_size;
+		};
+
+		/* Keep the outermost tags that are still wanted, and close the rest */
+		size_t keep = 0;
+		while (keep < open.size() && is_wanted(open[keep])) {
+			++keep;
+		}
+		while (open.size() > keep) {
+			append_close_tag (out, open.back());
+			open.pop_back();
+		}
+
+		for (int i = 0; i < wanted_size; ++i) {
+			if (std::find(open.begin(), open.end(), wanted[i]) == open.end()) {
+				append_open_tag (out, wanted[i]);
+				open.push_back (wanted[i]);
+			}
+		}
+
+		append_escaped (out, block.text);
+	}
+
+	while (!open.empty()) {
+		append_close_tag (out, open.back());
+		open.pop_back();
+	}
+}
+
+/** Format a subtitle as a WebVTT cue, followed by a blank line.
+ *  @return false if the subtitle has no text, in which case nothing is written.
+ */
+bool
+format_cue (string& out, Subtitle const& subtitle)
+{
+	out.clear ();
+	if (subtitle.lines.empty()) {
+		return false;
+	}
+
+	format_time<WebVTTTimeFormat> (subtitle.from, out);
+	out += " --> ";
+	format_time<WebVTTTimeFormat> (subtitle.to, out);
+	append_settings (out, subtitle);
+	out += '\n';
+
+	/* An empty line would end the cue, so leave out any lines with no text */
+	bool any = false;
+	for (auto const& i: subtitle.lines) {
+		auto const size = out.size();
+		append_line (out, i);
+		if (out.size() > size) {
+			out += '\n';
+			any = true;
+		}
+	}
+
+	out += '\n';
+	return any;
+}
+
+}
+
+WebVTTWriter::WebVTTWriter (std::ostream& out, vector<string> const& header)
+	: _out (out)
+{
+	_out << "WEBVTT\n";
+	for (auto const& i: header) {
+		_out << i << "\n";
+	}
+	_out << "\n";
+}
+
+void
+WebVTTWriter::write (Subtitle const& subtitle)
+{
+	if (format_cue(_cue, subtitle)) {
+		_out.write (_cue.data(), _cue.size());
+	}
+}
+
+void
+sub::write_web_vtt (vector<Subtitle> const& subtitles, std::ostream& out)
+{
+	WebVTTWriter writer (out);
+	for (auto const& i: subtitles) {
+		writer.write (i);
+	}
+}
+
+HLSWebVTTSegmenter::HLSWebVTTSegmenter (boost::filesystem::path directory, string name, int segment_length, int64_t mpegts_origin)
+	: _directory (directory)
+	, _name (name)
+	, _segment_length (segment_length)
+	, _mpegts_origin (mpegts_origin)
+{
+	SUB_ASSERT (segment_length > 0);
+
+	_playlist.open (playlist_path().string().c_str());
+	if (!_playlist.good()) {
+		throw FileError (String::compose("Could not open %1", playlist_path().string()));
+	}
+
+	_playlist << "#EXTM3U\n"
+		  << "#EXT-X-VERSION:3\n"
+		  << "#EXT-X-TARGETDURATION:" << _segment_length << "\n"
+		  << "#EXT-X-MEDIA-SEQUENCE:0\n"
+		  << "#EXT-X-PLAYLIST-TYPE:VOD\n";
+}
+
+boost::filesystem::path
+HLSWebVTTSegmenter::segment_path (int index) const
+{
+	char buffer[16];
+	snprintf (buffer, sizeof(buffer), "_%05d.vtt", index);
+	return _directory / (_name + buffer);
+}
+
+boost::filesystem::path
+HLSWebVTTSegmenter::playlist_path () const
+{
+	return _directory / (_name + ".m3u8");
+}
+
+Time
+HLSWebVTTSegmenter::segment_end () const
+{
+	/* Give this a rate so that it can be compared with any subtitle time that has one */
+	return Time::from_ticks (int64_t(_segment + 1) * _segment_length * Time::ticks_per_second, Rational(1, 1));
+}
+
+void
+HLSWebVTTSegmenter::write (Subtitle const& subtitle)
+{
+	if (_last_from && subtitle.from < *_last_from) {
+		throw CollectError ("Subtitles given to HLSWebVTTSegmenter must be in order of their start times");
+	}
+	_last_from = subtitle.from;
+
+	while (!(subtitle.from < segment_end())) {
+		write_segment ();
+	}
+
+	Cue cue;
+	cue.to = subtitle.to;
+	if (subtitle.from < subtitle.to && format_cue(cue.text, subtitle)) {
+		_pending.push_back (std::move(cue));
+	}
+}
+
+/** Write the current segment, with every pending cue, and move on to the next */
+void
+HLSWebVTTSegmenter::write_segment ()
+{
+	auto const path = segment_path (_segment);
+	std::ofstream segment (path.string().c_str());
+	if (!segment.good()) {
+		throw FileError (String::compose("Could not open %1", path.string()));
+	}
+
+	segment << "WEBVTT\n"
+		<< "X-TIMESTAMP-MAP=MPEGTS:" << (_mpegts_origin % HLSWebVTTReader::mpegts_wrap) << ",LOCAL:00:00:00.000\n"
+		<< "\n";
+
+	/* All pending cues started before the end of this segment and end after its start */
+	auto const end = segment_end ();
+	for (auto const& i: _pending) {
+		segment.write (i.text.data(), i.text.size());
+	}
+
+	if (!segment.good()) {
+		throw FileError (String::compose("Could not write to %1", path.string()));
+	}
+
+	_pending.erase (
+		std::remove_if(_pending.begin(), _pending.end(), [end](Cue const& cue) { return !(end < cue.to); }),
+		_pending.end()
+		);
+
+	_playlist << "#EXTINF:" << _segment_length << ".000,\n" << path.filename().string() << "\n";
+	++_segment;
+}
+
+void
+HLSWebVTTSegmenter::finish ()
+{
+	while (!_pending.empty()) {
+		write_segment ();
+	}
+
+	_playlist << "#EXT-X-ENDLIST\n";
+	_playlist.close ();
+	if (_playlist.fail()) {
+		throw FileError (String::compose("Could not write to %1", playlist_path().string()));
+	}
+}
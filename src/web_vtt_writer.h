@@ -0,0 +1,136 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  src/web_vtt_writer.h
+ *  @brief Writers for WebVTT files and HLS WebVTT segments.
+ */
+
+#ifndef LIBSUB_WEB_VTT_WRITER_H
+#define LIBSUB_WEB_VTT_WRITER_H
+
+#include "sub_time.h"
+#include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace sub {
+
+class Subtitle;
+
+/** @class WebVTTWriter
+ *  @brief Writes Subtitles to a stream as WebVTT, one at a time.
+ *
+ *  Bold, italic, underline and colour are written as cue markup; colours are given as
+ *  the nearest of WebVTT's default colour classes (c.red, c.yellow and so on).  Vertical
+ *  and horizontal positions are written as line, position and align cue settings, except
+ *  for ones relative to the top of the subtitle, which have no equivalent.
+ */
+class WebVTTWriter
+{
+public:
+	/** Write the header.
+	 *  @param out Stream to write to, which must remain valid for the lifetime of this object.
+	 *  @param header Lines to write after WEBVTT, e.g. "Kind: captions".
+	 */
+	explicit WebVTTWriter (std::ostream& out, std::vector<std::string> const& header = std::vector<std::string>());
+
+	WebVTTWriter (WebVTTWriter const&) = delete;
+	WebVTTWriter& operator= (WebVTTWriter const&) = delete;
+
+	void write (Subtitle const& subtitle);
+
+private:
+	std::ostream& _out;
+	std::string _cue;
+};
+
+extern void write_web_vtt (std::vector<Subtitle> const& subtitles, std::ostream& out);
+
+/** @class HLSWebVTTSegmenter
+ *  @brief Writes Subtitles as a series of WebVTT segment files and an HLS media playlist.
+ *
+ *  Segment n covers the time from n * segment_length seconds until the next segment, and
+ *  contains every cue which is visible during that time; cues which span a boundary
+ *  are written in full to each segment that they overlap.  Each segment has an
+ *  X-TIMESTAMP-MAP which puts time zero at mpegts_origin.
+ *
+ *  Subtitles must be given in order of their from times, as they come from OnlineCollector.
+ *  Each segment is written as soon as a subtitle starts after its end, so only
+ *  the subtitles which are visible in the current segment are held in memory.
+ */
+class HLSWebVTTSegmenter
+{
+public:
+	/** @param directory Directory to write to, which must exist.
+	 *  @param name Name for the files; segments are called name_00000.vtt and so on, and the playlist is name.m3u8.
+	 *  @param segment_length Length of each segment in seconds.
+	 *  @param mpegts_origin MPEG-TS time, in 90kHz units, of time zero.
+	 */
+	HLSWebVTTSegmenter (boost::filesystem::path directory, std::string name, int segment_length, int64_t mpegts_origin = 0);
+
+	HLSWebVTTSegmenter (HLSWebVTTSegmenter const&) = delete;
+	HLSWebVTTSegmenter& operator= (HLSWebVTTSegmenter const&) = delete;
+
+	void write (Subtitle const& subtitle);
+	/** Write the remaining segments and finish the playlist */
+	void finish ();
+
+	/** @return number of segments written so far */
+	int segments () const {
+		return _segment;
+	}
+
+	/** @return path of a segment file */
+	boost::filesystem::path segment_path (int index) const;
+	/** @return path of the playlist */
+	boost::filesystem::path playlist_path () const;
+
+private:
+	void write_segment ();
+	Time segment_end () const;
+
+	boost::filesystem::path _directory;
+	std::string _name;
+	int _segment_length;
+	int64_t _mpegts_origin;
+	std::ofstream _playlist;
+	/** index of the segment that is being filled */
+	int _segment = 0;
+	/** from time of the last subtitle that was written */
+	boost::optional<Time> _last_from;
+
+	struct Cue
+	{
+		Time to;
+		/** the cue formatted as WebVTT */
+		std::string text;
+	};
+
+	/** cues which are visible in the current segment or later, in order of their from times */
+	std::deque<Cue> _pending;
+};
+
+}
+
+#endif
@@ -0,0 +1,74 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "collect.h"
+#include "raw_subtitle.h"
+#include "subtitle.h"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+
+
+using std::vector;
+
+
+/** Check stable_order against std::stable_sort, for short and long inputs with duplicate and negative keys */
+BOOST_AUTO_TEST_CASE (stable_order_test)
+{
+	srand (1);
+
+	for (auto size: { 0, 1, 10, 255, 256, 10000 }) {
+		vector<int64_t> keys;
+		for (int i = 0; i < size; ++i) {
+			keys.push_back ((int64_t(rand() % 2000) - 1000) * sub::Time::ticks_per_second);
+		}
+
+		vector<size_t> reference (keys.size());
+		std::iota (reference.begin(), reference.end(), 0);
+		std::stable_sort (reference.begin(), reference.end(), [&keys](size_t a, size_t b) { return keys[a] < keys[b]; });
+
+		BOOST_CHECK_MESSAGE (sub::stable_order(keys) == reference, "size " << size);
+	}
+}
+
+
+/** Check that collect() gives the same result whether or not its input needs sorting */
+BOOST_AUTO_TEST_CASE (collect_unsorted_test)
+{
+	vector<sub::RawSubtitle> raw;
+	for (int i = 0; i < 1000; ++i) {
+		sub::RawSubtitle r;
+		r.text = std::to_string (i);
+		r.from = sub::Time::from_hms (0, 0, (i * 7919) % 300, 0);
+		r.to = sub::Time::from_hms (0, 0, 301, 0);
+		r.vertical_position.line = 0;
+		r.vertical_position.reference = sub::TOP_OF_SUBTITLE;
+		raw.push_back (r);
+	}
+
+	auto sorted = raw;
+	std::stable_sort (sorted.begin(), sorted.end());
+
+	auto const a = sub::collect<vector<sub::Subtitle>> (raw);
+	auto const b = sub::collect<vector<sub::Subtitle>> (sorted);
+	BOOST_CHECK_EQUAL (a.size(), 300U);
+	BOOST_CHECK (a == b);
+}
@@ -0,0 +1,94 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "diagnostic.h"
+#include "line_source.h"
+#include "stl_text_reader.h"
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <sstream>
+
+
+using std::make_shared;
+using std::string;
+
+
+/** Check that STLTextReader reports where its problems are */
+BOOST_AUTO_TEST_CASE (stl_text_reader_diagnostics_test)
+{
+	string const stl =
+		"$FontName = Arial\n"
+		"00:00:01:00 , 00:00:02:00 , Hello\n"
+		"this is nonsense\n"
+		"00:00:0x:00 , 00:00:04:00 , Bad time\n";
+
+	auto sink = make_shared<sub::CollectingDiagnosticSink>();
+	sub::MemoryLineSource source (stl.data(), stl.size());
+	sub::STLTextReader reader (source, sink);
+	BOOST_CHECK_EQUAL (reader.subtitles().size(), 1U);
+
+	auto const diagnostics = sink->diagnostics();
+	BOOST_REQUIRE_EQUAL (diagnostics.size(), 3U);
+
+	BOOST_CHECK (diagnostics[0].code == sub::DiagnosticCode::UNRECOGNISED_LINE);
+	BOOST_CHECK (diagnostics[0].severity == sub::DiagnosticSeverity::WARNING);
+	BOOST_CHECK_EQUAL (diagnostics[0].line.get(), 3);
+	BOOST_CHECK_EQUAL (diagnostics[0].offset.get(), 52);
+	BOOST_CHECK_EQUAL (diagnostics[0].message, "Unrecognised line this is nonsense");
+
+	BOOST_CHECK (diagnostics[1].code == sub::DiagnosticCode::UNRECOGNISED_TIME);
+	BOOST_CHECK_EQUAL (diagnostics[1].line.get(), 4);
+	BOOST_CHECK (diagnostics[2].code == sub::DiagnosticCode::UNRECOGNISED_LINE);
+	BOOST_CHECK_EQUAL (diagnostics[2].line.get(), 4);
+
+	/* Reading from a stream should give the same positions */
+	auto stream_sink = make_shared<sub::CollectingDiagnosticSink>();
+	std::istringstream in (stl);
+	sub::STLTextReader stream_reader (in, stream_sink);
+	auto const stream_diagnostics = stream_sink->diagnostics();
+	BOOST_REQUIRE_EQUAL (stream_diagnostics.size(), 3U);
+	for (size_t i = 0; i < diagnostics.size(); ++i) {
+		BOOST_CHECK_EQUAL (stream_diagnostics[i].line.get(), diagnostics[i].line.get());
+		BOOST_CHECK_EQUAL (stream_diagnostics[i].offset.get(), diagnostics[i].offset.get());
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE (limiting_diagnostic_sink_test)
+{
+	auto collect = make_shared<sub::CollectingDiagnosticSink>();
+	sub::LimitingDiagnosticSink limit (collect, 2);
+
+	for (int i = 0; i < 5; ++i) {
+		limit.report (sub::Diagnostic(sub::DiagnosticSeverity::WARNING, sub::DiagnosticCode::UNRECOGNISED_LINE, "bad line", i + 1));
+	}
+	limit.report (sub::Diagnostic(sub::DiagnosticSeverity::WARNING, sub::DiagnosticCode::UNRECOGNISED_TIME, "bad time"));
+
+	BOOST_CHECK_EQUAL (collect->diagnostics().size(), 3U);
+
+	limit.flush ();
+	auto const diagnostics = collect->diagnostics();
+	BOOST_REQUIRE_EQUAL (diagnostics.size(), 4U);
+	BOOST_CHECK (diagnostics[3].code == sub::DiagnosticCode::SUPPRESSED);
+	BOOST_CHECK_EQUAL (diagnostics[3].message, "3 more unrecognised-line diagnostics were suppressed");
+
+	std::ostringstream s;
+	s << diagnostics[1];
+	BOOST_CHECK_EQUAL (s.str(), "warning: line 2: bad line [unrecognised-line]");
+}
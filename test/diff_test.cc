@@ -0,0 +1,131 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "diff.h"
+#include "subtitle.h"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+
+using std::string;
+using std::vector;
+
+
+static sub::Subtitle
+make (int from, int to, string text)
+{
+	sub::Block b;
+	b.text = text;
+
+	sub::Line l;
+	l.vertical_position.line = 0;
+	l.vertical_position.reference = sub::TOP_OF_SUBTITLE;
+	l.blocks.push_back (b);
+
+	sub::Subtitle s;
+	s.from = sub::Time::from_hms (0, 0, from, 0);
+	s.to = sub::Time::from_hms (0, 0, to, 0);
+	s.lines.push_back (l);
+	return s;
+}
+
+
+BOOST_AUTO_TEST_CASE (diff_test)
+{
+	vector<sub::Subtitle> a = {
+		make (1, 2, "same"),
+		make (3, 4, "retimed"),
+		make (5, 6, "changed"),
+		make (7, 8, "deleted"),
+		make (9, 11, "moved and changed")
+	};
+
+	vector<sub::Subtitle> b = {
+		make (1, 2, "same"),
+		make (3, 5, "retimed"),
+		make (5, 6, "Changed"),
+		make (10, 12, "Moved and changed"),
+		make (13, 14, "inserted")
+	};
+
+	auto const changes = sub::diff (a, b);
+	BOOST_REQUIRE_EQUAL (changes.size(), 5U);
+
+	BOOST_CHECK (changes[0].type == sub::Change::Type::RETIMED);
+	BOOST_CHECK_EQUAL (*changes[0].a, 1U);
+	BOOST_CHECK_EQUAL (*changes[0].b, 1U);
+
+	BOOST_CHECK (changes[1].type == sub::Change::Type::CHANGED);
+	BOOST_CHECK_EQUAL (*changes[1].a, 2U);
+	BOOST_CHECK (!changes[1].retimed);
+
+	BOOST_CHECK (changes[2].type == sub::Change::Type::DELETED);
+	BOOST_CHECK_EQUAL (*changes[2].a, 3U);
+	BOOST_CHECK (!changes[2].b);
+
+	BOOST_CHECK (changes[3].type == sub::Change::Type::CHANGED);
+	BOOST_CHECK_EQUAL (*changes[3].a, 4U);
+	BOOST_CHECK_EQUAL (*changes[3].b, 3U);
+	BOOST_CHECK (changes[3].retimed);
+
+	BOOST_CHECK (changes[4].type == sub::Change::Type::INSERTED);
+	BOOST_CHECK_EQUAL (*changes[4].b, 4U);
+
+	BOOST_CHECK (sub::diff(a, a).empty());
+}
+
+
+/** Check that a large track with a few changes is compared correctly, whatever order it is in */
+/** Check that subtitles which differ only in their fades are RETIMED, not CHANGED */
+BOOST_AUTO_TEST_CASE (diff_fade_test)
+{
+	vector<sub::Subtitle> a = { make (1, 2, "faded") };
+	vector<sub::Subtitle> b = { make (1, 2, "faded") };
+	b[0].fade_up = sub::Time::from_hms (0, 0, 0, 200);
+
+	auto const changes = sub::diff (a, b);
+	BOOST_REQUIRE_EQUAL (changes.size(), 1U);
+	BOOST_CHECK (changes[0].type == sub::Change::Type::RETIMED);
+	BOOST_CHECK_EQUAL (*changes[0].a, 0U);
+	BOOST_CHECK_EQUAL (*changes[0].b, 0U);
+	BOOST_CHECK (!changes[0].retimed);
+}
+
+
+BOOST_AUTO_TEST_CASE (diff_large_test)
+{
+	vector<sub::Subtitle> a;
+	for (int i = 0; i < 100000; ++i) {
+		a.push_back (make(i * 2, i * 2 + 1, std::to_string(i)));
+	}
+
+	auto b = a;
+	b[500].lines[0].blocks[0].text = "different";
+	b.erase (b.begin() + 1000);
+	std::reverse (b.begin(), b.end());
+
+	auto const changes = sub::diff (a, b);
+	BOOST_REQUIRE_EQUAL (changes.size(), 2U);
+	BOOST_CHECK (changes[0].type == sub::Change::Type::CHANGED);
+	BOOST_CHECK_EQUAL (*changes[0].a, 500U);
+	BOOST_CHECK (changes[1].type == sub::Change::Type::DELETED);
+	BOOST_CHECK_EQUAL (*changes[1].a, 1000U);
+}
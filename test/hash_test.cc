@@ -0,0 +1,101 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "hash.h"
+#include "subtitle.h"
+#include <boost/test/unit_test.hpp>
+#include <unordered_set>
+
+
+static sub::Subtitle
+make_subtitle (std::string text)
+{
+	sub::Block b;
+	b.text = text;
+	b.font = std::string ("Arial");
+	b.font_size.set_points (42);
+
+	sub::Line l;
+	l.vertical_position.line = 0;
+	l.vertical_position.reference = sub::TOP_OF_SUBTITLE;
+	l.blocks.push_back (b);
+
+	sub::Subtitle s;
+	s.from = sub::Time::from_hms (0, 0, 1, 0);
+	s.to = sub::Time::from_hmsf (0, 0, 2, 12, sub::Rational(24, 1));
+	s.lines.push_back (l);
+	return s;
+}
+
+
+/** Check that things which are equal have the same hash */
+BOOST_AUTO_TEST_CASE (hash_equal_test)
+{
+	auto const a = sub::Time::from_hmsf (0, 0, 1, 12, sub::Rational(24, 1));
+	auto const b = sub::Time::from_hms (0, 0, 1, 500);
+	BOOST_REQUIRE (a == b);
+	BOOST_CHECK_EQUAL (sub::content_hash(a), sub::content_hash(b));
+	BOOST_CHECK (sub::content_hash(a) != sub::content_hash(sub::Time::from_hms(0, 0, 1, 501)));
+
+	sub::HorizontalPosition h1;
+	h1.proportional = 0.5;
+	sub::HorizontalPosition h2;
+	h2.proportional = 0.5001;
+	BOOST_REQUIRE (h1 == h2);
+	BOOST_CHECK_EQUAL (std::hash<sub::HorizontalPosition>()(h1), std::hash<sub::HorizontalPosition>()(h2));
+
+	BOOST_CHECK_EQUAL (sub::content_hash(sub::Colour(0, 1, 0)), sub::content_hash(sub::Colour(-0.0f, 1, 0)));
+
+	auto const s1 = make_subtitle ("Hello");
+	auto s2 = make_subtitle ("Hello");
+	s2.from = sub::Time::from_hmsf (0, 0, 1, 0, sub::Rational(25, 1));
+	BOOST_REQUIRE (s1 == s2);
+	BOOST_CHECK_EQUAL (sub::content_hash(s1), sub::content_hash(s2));
+	BOOST_CHECK (sub::content_hash(s1) != sub::content_hash(make_subtitle("Hullo")));
+}
+
+
+/** Check that the hash of a Subtitle can be made from saved hashes of its lines */
+BOOST_AUTO_TEST_CASE (hash_incremental_test)
+{
+	auto const s = make_subtitle ("Hello");
+
+	sub::Hasher h;
+	h.add (s.from);
+	h.add (s.to);
+	h.add (s.fade_up);
+	h.add (s.fade_down);
+	h.add (static_cast<uint64_t>(s.lines.size()));
+	h.add (sub::content_hash(s.lines[0]));
+	BOOST_CHECK_EQUAL (h.get(), sub::content_hash(s));
+}
+
+
+/** Check that hashes do not change, as they may be stored */
+BOOST_AUTO_TEST_CASE (hash_stable_test)
+{
+	BOOST_CHECK_EQUAL (sub::content_hash(std::string("libsub")), 12485685477237361890ULL);
+	BOOST_CHECK_EQUAL (sub::content_hash(make_subtitle("Hello")), 4872331806155001744ULL);
+
+	std::unordered_set<sub::Subtitle> set;
+	set.insert (make_subtitle("Hello"));
+	set.insert (make_subtitle("Hello"));
+	set.insert (make_subtitle("Goodbye"));
+	BOOST_CHECK_EQUAL (set.size(), 2U);
+}
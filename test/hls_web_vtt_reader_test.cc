@@ -0,0 +1,125 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "exceptions.h"
+#include "hls_web_vtt_reader.h"
+#include "line_source.h"
+#include "web_vtt_reader.h"
+#include <boost/test/unit_test.hpp>
+#include <string>
+
+
+using std::string;
+
+
+BOOST_AUTO_TEST_CASE(vtt_reader_metadata_test)
+{
+	string const vtt =
+		"WEBVTT\n"
+		"X-TIMESTAMP-MAP=MPEGTS:900000,LOCAL:00:00:00.000\n"
+		"Kind: captions\n"
+		"\n"
+		"00:00:01.000 --> 00:00:02.000\nOne\n";
+
+	sub::MemoryLineSource source(vtt.data(), vtt.size());
+	sub::WebVTTReader reader(source);
+
+	auto const metadata = reader.metadata();
+	BOOST_REQUIRE_EQUAL(metadata.size(), 2U);
+	BOOST_CHECK_EQUAL(metadata.at("X-TIMESTAMP-MAP"), "MPEGTS:900000,LOCAL:00:00:00.000");
+	BOOST_CHECK_EQUAL(metadata.at("Kind"), "captions");
+	BOOST_REQUIRE_EQUAL(reader.subtitles().size(), 1U);
+}
+
+
+/** Check that times are mapped using X-TIMESTAMP-MAP and that a cue repeated
+ *  in the next segment is only seen once.
+ */
+BOOST_AUTO_TEST_CASE(hls_web_vtt_reader_test)
+{
+	sub::HLSWebVTTReader reader(900000);
+
+	reader.add_segment(string(
+		"WEBVTT\n"
+		"X-TIMESTAMP-MAP=MPEGTS:900000,LOCAL:00:00:00.000\n"
+		"\n"
+		"00:00:00.000 --> 00:00:02.000\nA\n\n"
+		"00:00:05.000 --> 00:00:07.000\nB\n"
+		));
+
+	BOOST_CHECK_EQUAL(reader.subtitles().size(), 2U);
+
+	/* This segment's local time 6s is MPEG-TS 16s, which is 6s from the origin */
+	reader.add_segment(string(
+		"WEBVTT\n"
+		"X-TIMESTAMP-MAP=LOCAL:00:00:06.000,MPEGTS:1440000\n"
+		"\n"
+		"00:00:05.000 --> 00:00:07.000\nB\n\n"
+		"00:00:08.000 --> 00:00:09.000\nC\n"
+		));
+
+	auto const subs = reader.subtitles();
+	BOOST_REQUIRE_EQUAL(subs.size(), 3U);
+	BOOST_CHECK_EQUAL(subs[0].text, "A");
+	BOOST_CHECK_EQUAL(subs[0].from, sub::Time::from_hms(0, 0, 0, 0));
+	BOOST_CHECK_EQUAL(subs[1].text, "B");
+	BOOST_CHECK_EQUAL(subs[1].from, sub::Time::from_hms(0, 0, 5, 0));
+	BOOST_CHECK_EQUAL(subs[1].to, sub::Time::from_hms(0, 0, 7, 0));
+	BOOST_CHECK_EQUAL(subs[2].text, "C");
+	BOOST_CHECK_EQUAL(subs[2].from, sub::Time::from_hms(0, 0, 8, 0));
+	BOOST_CHECK_EQUAL(reader.repeated_cues(), 1);
+}
+
+
+/** Check that MPEG-TS time stamps which wrap around are followed */
+BOOST_AUTO_TEST_CASE(hls_web_vtt_reader_wrap_test)
+{
+	int64_t const origin = sub::HLSWebVTTReader::mpegts_wrap - 90000;
+	sub::HLSWebVTTReader reader(origin);
+
+	reader.add_segment(string(
+		"WEBVTT\n"
+		"X-TIMESTAMP-MAP=MPEGTS:" + std::to_string(origin) + ",LOCAL:00:00:00.000\n"
+		"\n"
+		"00:00:00.500 --> 00:00:00.750\nA\n"
+		));
+
+	/* 2s after the origin, having wrapped */
+	reader.add_segment(string(
+		"WEBVTT\n"
+		"X-TIMESTAMP-MAP=MPEGTS:90000,LOCAL:00:00:00.000\n"
+		"\n"
+		"00:00:01.000 --> 00:00:01.500\nB\n"
+		));
+
+	auto const subs = reader.subtitles();
+	BOOST_REQUIRE_EQUAL(subs.size(), 2U);
+	BOOST_CHECK_EQUAL(subs[1].from, sub::Time::from_hms(0, 0, 3, 0));
+	BOOST_CHECK_EQUAL(subs[1].to, sub::Time::from_hms(0, 0, 3, 500));
+}
+
+
+BOOST_AUTO_TEST_CASE(hls_web_vtt_reader_bad_map_test)
+{
+	sub::HLSWebVTTReader reader;
+	BOOST_CHECK_THROW(
+		reader.add_segment(string("WEBVTT\nX-TIMESTAMP-MAP=MPEGTS:xyz,LOCAL:00:00:00.000\n\n00:00:01.000 --> 00:00:02.000\nA\n")),
+		sub::WebVTTError
+		);
+}
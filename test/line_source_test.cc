@@ -0,0 +1,119 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "collect.h"
+#include "line_source.h"
+#include "subrip_reader.h"
+#include "subtitle.h"
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+using std::string;
+using std::vector;
+
+
+static vector<sub::SourceLine>
+all_lines (sub::LineSource& source, vector<string>& text)
+{
+	vector<sub::SourceLine> lines;
+	sub::SourceLine line;
+	while (source.get(line)) {
+		lines.push_back(line);
+		text.push_back(line.string());
+	}
+	return lines;
+}
+
+
+BOOST_AUTO_TEST_CASE(memory_line_source_test)
+{
+	string const input = "one\r\ntwo\n\nthree";
+	sub::MemoryLineSource source(input.data(), input.size());
+
+	vector<string> text;
+	auto lines = all_lines(source, text);
+
+	BOOST_REQUIRE_EQUAL(lines.size(), 4U);
+	BOOST_CHECK_EQUAL(text[0], "one\r");
+	BOOST_CHECK_EQUAL(text[1], "two");
+	BOOST_CHECK_EQUAL(text[2], "");
+	BOOST_CHECK_EQUAL(text[3], "three");
+
+	BOOST_CHECK_EQUAL(lines[0].number, 1);
+	BOOST_CHECK_EQUAL(lines[3].number, 4);
+	BOOST_CHECK_EQUAL(lines[0].offset, 0);
+	BOOST_CHECK_EQUAL(lines[1].offset, 5);
+	BOOST_CHECK_EQUAL(lines[2].offset, 9);
+	BOOST_CHECK_EQUAL(lines[3].offset, 10);
+}
+
+
+/** Check that a line longer than the buffer comes back in one piece, and
+ *  that a trailing newline does not give an extra empty line.
+ */
+BOOST_AUTO_TEST_CASE(file_line_source_test)
+{
+	string const long_line(5000, 'x');
+
+	boost::filesystem::path const path = "build/test/file_line_source_test.txt";
+	auto f = fopen(path.string().c_str(), "wb");
+	BOOST_REQUIRE(f);
+	fprintf(f, "short\n%s\nend\n", long_line.c_str());
+	fclose(f);
+
+	f = fopen(path.string().c_str(), "rb");
+	BOOST_REQUIRE(f);
+	sub::FileLineSource source(f, 64);
+	vector<string> text;
+	auto lines = all_lines(source, text);
+	fclose(f);
+
+	BOOST_REQUIRE_EQUAL(lines.size(), 3U);
+	BOOST_CHECK_EQUAL(text[0], "short");
+	BOOST_CHECK_EQUAL(text[1], long_line);
+	BOOST_CHECK_EQUAL(text[2], "end");
+	BOOST_CHECK_EQUAL(lines[2].number, 3);
+	BOOST_CHECK_EQUAL(lines[2].offset, 5007);
+
+	sub::MappedLineSource mapped(path);
+	vector<string> mapped_text;
+	all_lines(mapped, mapped_text);
+	BOOST_CHECK(mapped_text == text);
+}
+
+
+/** Check that all ways of reading a SubRip file give the same result */
+BOOST_AUTO_TEST_CASE(subrip_line_sources_test)
+{
+	auto f = fopen("test/data/test2.srt", "r");
+	BOOST_REQUIRE(f);
+	sub::SubripReader from_file(f);
+	fclose(f);
+
+	sub::MappedLineSource source("test/data/test2.srt");
+	sub::SubripReader from_mapped(source);
+
+	auto a = sub::collect<vector<sub::Subtitle>>(from_file.subtitles());
+	auto b = sub::collect<vector<sub::Subtitle>>(from_mapped.subtitles());
+	BOOST_CHECK_EQUAL(a.size(), 7U);
+	BOOST_CHECK(a == b);
+}
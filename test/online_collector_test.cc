@@ -0,0 +1,105 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "collect.h"
+#include "exceptions.h"
+#include "online_collector.h"
+#include "subrip_push_parser.h"
+#include "subrip_reader.h"
+#include "subtitle.h"
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+using std::string;
+using std::vector;
+
+
+static sub::RawSubtitle
+fragment (int from, int to, string text)
+{
+	sub::RawSubtitle r;
+	r.text = text;
+	r.from = sub::Time::from_hms (0, 0, from, 0);
+	r.to = sub::Time::from_hms (0, 0, to, 0);
+	r.vertical_position.line = 0;
+	r.vertical_position.reference = sub::TOP_OF_SUBTITLE;
+	return r;
+}
+
+
+/** Check that OnlineCollector gives the same result as collect() for a whole file, and
+ *  that it emits subtitles before it has been given all of the input.
+ */
+BOOST_AUTO_TEST_CASE (online_collector_subrip_test)
+{
+	std::ifstream in ("test/data/test2.srt", std::ios::binary);
+	string const data (std::istreambuf_iterator<char>(in), (std::istreambuf_iterator<char>()));
+
+	sub::SubripReader reader (data);
+	auto const reference = sub::collect<vector<sub::Subtitle>> (reader.subtitles());
+	BOOST_REQUIRE_EQUAL (reference.size(), 7U);
+
+	vector<sub::Subtitle> subs;
+	sub::OnlineCollector collector ([&subs](sub::Subtitle s) { subs.push_back(s); }, 0);
+	sub::SubripPushParser parser ([&collector](sub::RawSubtitle const& s) { collector.add(s); });
+	parser.feed (data.data(), data.size() / 2);
+	BOOST_CHECK (!subs.empty());
+	parser.feed (data.data() + data.size() / 2, data.size() - data.size() / 2);
+	parser.finish ();
+	collector.finish ();
+
+	BOOST_CHECK (subs == reference);
+}
+
+
+/** Check that input which is out of order by less than the window is sorted, and that
+ *  input which is further out of order is rejected.
+ */
+BOOST_AUTO_TEST_CASE (online_collector_window_test)
+{
+	vector<sub::RawSubtitle> raw = {
+		fragment (1, 2, "a"),
+		fragment (3, 4, "c"),
+		fragment (2, 3, "b"),
+		fragment (3, 4, "d"),
+		fragment (4, 5, "e")
+	};
+
+	vector<sub::Subtitle> subs;
+	sub::OnlineCollector collector ([&subs](sub::Subtitle s) { subs.push_back(s); }, 1);
+	for (auto const& i: raw) {
+		collector.add (i);
+	}
+	collector.finish ();
+
+	BOOST_CHECK (subs == sub::collect<vector<sub::Subtitle>>(raw));
+	BOOST_REQUIRE_EQUAL (subs.size(), 4U);
+	BOOST_REQUIRE_EQUAL (subs[2].lines.size(), 1U);
+	BOOST_REQUIRE_EQUAL (subs[2].lines[0].blocks.size(), 2U);
+	BOOST_CHECK_EQUAL (subs[2].lines[0].blocks[0].text, "c");
+	BOOST_CHECK_EQUAL (subs[2].lines[0].blocks[1].text, "d");
+
+	sub::OnlineCollector strict ([](sub::Subtitle) {}, 0);
+	strict.add (fragment(3, 4, "c"));
+	BOOST_CHECK_THROW (strict.add(fragment(2, 3, "b")), sub::CollectError);
+}
@@ -0,0 +1,116 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "collect.h"
+#include "subrip_push_parser.h"
+#include "subrip_reader.h"
+#include "subtitle.h"
+#include "web_vtt_push_parser.h"
+#include "web_vtt_reader.h"
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+using std::string;
+using std::vector;
+
+
+static string
+read_file (string path)
+{
+	std::ifstream in (path, std::ios::binary);
+	return string (std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+
+/** Feed the whole of data to a parser in chunks of chunk bytes */
+template <class Parser>
+vector<sub::RawSubtitle>
+push_parse (string const& data, size_t chunk)
+{
+	vector<sub::RawSubtitle> subs;
+	Parser parser ([&subs](sub::RawSubtitle const& s) { subs.push_back(s); });
+	for (size_t i = 0; i < data.size(); i += chunk) {
+		parser.feed (data.data() + i, std::min(chunk, data.size() - i));
+	}
+	parser.finish ();
+	return subs;
+}
+
+
+/** Check that a SubRip file gives the same subtitles however it is split up */
+BOOST_AUTO_TEST_CASE (subrip_push_parser_test)
+{
+	auto const data = read_file ("test/data/test2.srt");
+	sub::SubripReader reader (data);
+	auto const reference = sub::collect<vector<sub::Subtitle>> (reader.subtitles());
+	BOOST_REQUIRE_EQUAL (reference.size(), 7U);
+
+	for (auto chunk: { 1, 2, 3, 7, 64, 100000 }) {
+		auto subs = sub::collect<vector<sub::Subtitle>> (push_parse<sub::SubripPushParser>(data, chunk));
+		BOOST_CHECK_MESSAGE (subs == reference, "chunk size " << chunk);
+	}
+}
+
+
+/** Check that a WebVTT file gives the same subtitles however it is split up */
+BOOST_AUTO_TEST_CASE (web_vtt_push_parser_test)
+{
+	auto const data = read_file ("test/data/test.vtt");
+	sub::WebVTTReader reader (data);
+	auto const reference = sub::collect<vector<sub::Subtitle>> (reader.subtitles());
+	BOOST_REQUIRE_EQUAL (reference.size(), 2U);
+
+	for (auto chunk: { 1, 2, 5, 64, 100000 }) {
+		auto subs = sub::collect<vector<sub::Subtitle>> (push_parse<sub::WebVTTPushParser>(data, chunk));
+		BOOST_CHECK_MESSAGE (subs == reference, "chunk size " << chunk);
+	}
+}
+
+
+/** Check that a cue is handed over as soon as its terminating blank line arrives,
+ *  and that splitting a UTF-8 sequence between feeds does no harm.
+ */
+BOOST_AUTO_TEST_CASE (subrip_push_parser_latency_test)
+{
+	vector<sub::RawSubtitle> subs;
+	sub::SubripPushParser parser ([&subs](sub::RawSubtitle const& s) { subs.push_back(s); });
+
+	string const first = "1\r\n00:00:01,000 --> 00:00:02,500\r\nCaf\xc3";
+	parser.feed (first.data(), first.size());
+	BOOST_CHECK (subs.empty());
+
+	string const second = "\xa9 au lait\r\n";
+	parser.feed (second.data(), second.size());
+	BOOST_CHECK (subs.empty());
+
+	string const third = "\r\n2\r\n00:00:03,000 --> 00:00:04,000\r\nNext";
+	parser.feed (third.data(), third.size());
+	BOOST_REQUIRE_EQUAL (subs.size(), 1U);
+	BOOST_CHECK_EQUAL (subs[0].text, "Caf\xc3\xa9 au lait");
+	BOOST_CHECK_EQUAL (subs[0].from, sub::Time::from_hms(0, 0, 1, 0));
+	BOOST_CHECK_EQUAL (subs[0].to, sub::Time::from_hms(0, 0, 2, 500));
+
+	parser.finish ();
+	BOOST_REQUIRE_EQUAL (subs.size(), 2U);
+	BOOST_CHECK_EQUAL (subs[1].text, "Next");
+}
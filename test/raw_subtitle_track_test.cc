@@ -0,0 +1,143 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "collect.h"
+#include "line_source.h"
+#include "raw_subtitle_track.h"
+#include "ssa_reader.h"
+#include "subrip_reader.h"
+#include "subtitle.h"
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <vector>
+
+
+using std::make_shared;
+using std::vector;
+
+
+/** Check that a track gives back what was put into it */
+BOOST_AUTO_TEST_CASE (raw_subtitle_track_test)
+{
+	sub::MappedLineSource source ("test/data/test.ssa");
+	sub::SSAReader reader (source);
+	auto const subs = reader.subtitles ();
+	BOOST_REQUIRE (!subs.empty());
+
+	sub::RawSubtitleTrack track;
+	for (auto const& i: subs) {
+		track.push_back (i);
+	}
+
+	BOOST_REQUIRE_EQUAL (track.size(), subs.size());
+	BOOST_CHECK (track.styles() < subs.size());
+
+	for (size_t i = 0; i < subs.size(); ++i) {
+		BOOST_CHECK_EQUAL (track.text(i), subs[i].text);
+		BOOST_CHECK_EQUAL (track.text_size(i), subs[i].text.size());
+		BOOST_CHECK_EQUAL (track.from(i), subs[i].from);
+		BOOST_CHECK_EQUAL (track.to(i), subs[i].to);
+		BOOST_CHECK (track.horizontal_position(i) == subs[i].horizontal_position);
+		BOOST_CHECK (track[i].vertical_position.proportional == subs[i].vertical_position.proportional);
+		BOOST_CHECK (track[i].vertical_position.line == subs[i].vertical_position.line);
+		BOOST_CHECK (track[i].vertical_position.lines == subs[i].vertical_position.lines);
+		BOOST_CHECK (track[i].vertical_position.reference == subs[i].vertical_position.reference);
+		BOOST_CHECK (track[i].font == subs[i].font);
+		BOOST_CHECK (track[i].colour == subs[i].colour);
+		BOOST_CHECK_EQUAL (track[i].italic, subs[i].italic);
+	}
+
+	auto a = sub::collect<vector<sub::Subtitle>> (subs);
+	auto b = sub::collect<vector<sub::Subtitle>> (track.subtitles());
+	BOOST_CHECK (a == b);
+
+	track.clear ();
+	BOOST_CHECK (track.empty());
+	BOOST_CHECK_EQUAL (track.styles(), 0U);
+}
+
+
+/** Check that fragments with the same formatting share a style id */
+BOOST_AUTO_TEST_CASE (raw_subtitle_track_style_test)
+{
+	sub::RawSubtitle plain;
+	plain.text = "plain";
+	sub::RawSubtitle italic;
+	italic.text = "italic";
+	italic.italic = true;
+	sub::RawSubtitle fade;
+	fade.text = "fade";
+	fade.fade_up = sub::Time::from_hms (0, 0, 1, 0);
+
+	sub::RawSubtitleTrack track;
+	track.push_back (plain);
+	track.push_back (italic);
+	track.push_back (plain);
+	track.push_back (fade);
+
+	BOOST_CHECK_EQUAL (track.styles(), 2U);
+	BOOST_CHECK_EQUAL (track.style_id(0), track.style_id(2));
+	BOOST_CHECK (track.style_id(0) != track.style_id(1));
+	BOOST_CHECK_EQUAL (track.style_id(0), track.style_id(3));
+	BOOST_CHECK (!track[2].fade_up);
+	BOOST_REQUIRE (track[3].fade_up);
+	BOOST_CHECK_EQUAL (track[3].fade_up.get(), sub::Time::from_hms(0, 0, 1, 0));
+	BOOST_CHECK_EQUAL (track.text(1), "italic");
+}
+
+
+/** Check that a position with more lines than would fit in 16 bits is kept as it was */
+BOOST_AUTO_TEST_CASE (raw_subtitle_track_many_lines_test)
+{
+	sub::RawSubtitle s;
+	s.text = "many lines";
+	s.vertical_position.line = 70000;
+	s.vertical_position.lines = 100000;
+	s.vertical_position.reference = sub::TOP_OF_SCREEN;
+
+	sub::RawSubtitleTrack track;
+	track.push_back (s);
+
+	BOOST_CHECK (track.vertical_position(0) == s.vertical_position);
+	BOOST_CHECK_EQUAL (track.vertical_position(0).lines.get(), 100000);
+}
+
+
+/** Check that a streaming reader can fill a track */
+BOOST_AUTO_TEST_CASE (reader_read_track_test)
+{
+	sub::SubripReader reader (make_shared<sub::MappedLineSource>("test/data/test2.srt"));
+	/* Take one subtitle out first, to check that the rest still end up in the track */
+	auto first = reader.next ();
+	BOOST_REQUIRE (first);
+
+	sub::RawSubtitleTrack track;
+	reader.read (track);
+	BOOST_CHECK (reader.subtitles().empty());
+	BOOST_CHECK (!reader.next());
+
+	sub::MappedLineSource source ("test/data/test2.srt");
+	sub::SubripReader eager (source);
+	auto all = eager.subtitles ();
+	BOOST_REQUIRE_EQUAL (track.size() + 1, all.size());
+	BOOST_CHECK_EQUAL (first->text, all[0].text);
+	for (size_t i = 0; i < track.size(); ++i) {
+		BOOST_CHECK_EQUAL (track.text(i), all[i + 1].text);
+	}
+}
@@ -0,0 +1,112 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "collect.h"
+#include "reader_factory.h"
+#include "ssa_reader.h"
+#include "stl_text_reader.h"
+#include "subrip_reader.h"
+#include "subtitle.h"
+#include "web_vtt_reader.h"
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+using std::dynamic_pointer_cast;
+using std::string;
+using std::vector;
+
+
+static sub::SubtitleFormat
+probe (string data, string extension = "")
+{
+	return sub::probe_format (data.data(), data.size(), extension);
+}
+
+
+BOOST_AUTO_TEST_CASE (probe_format_test)
+{
+	BOOST_CHECK (probe("850STL25.01\x31\x30\x30") == sub::SubtitleFormat::STL_BINARY);
+	BOOST_CHECK (probe("WEBVTT\n\n00:00.000 --> 00:01.000\nHello\n") == sub::SubtitleFormat::WEBVTT);
+	BOOST_CHECK (probe("\xef\xbb\xbfWEBVTT - title\r\n") == sub::SubtitleFormat::WEBVTT);
+	BOOST_CHECK (probe("\n\n[Script Info]\nTitle: foo\n") == sub::SubtitleFormat::SSA);
+	BOOST_CHECK (probe("\xef\xbb\xbf" "1\r\n00:00:01,000 --> 00:00:02,000\r\nHello\r\n") == sub::SubtitleFormat::SUBRIP);
+	BOOST_CHECK (probe("$FontName = Arial\n") == sub::SubtitleFormat::STL_TEXT);
+	BOOST_CHECK (probe("00:00:41:09 , 00:00:42:21 , Hello\n") == sub::SubtitleFormat::STL_TEXT);
+
+	/* Content which doesn't say what it is */
+	BOOST_CHECK (probe("Hello world\n") == sub::SubtitleFormat::UNKNOWN);
+	BOOST_CHECK (probe("") == sub::SubtitleFormat::UNKNOWN);
+	BOOST_CHECK (probe("", ".SRT") == sub::SubtitleFormat::SUBRIP);
+	BOOST_CHECK (probe("", ".ass") == sub::SubtitleFormat::SSA);
+	BOOST_CHECK (probe("", ".vtt") == sub::SubtitleFormat::WEBVTT);
+
+	/* Content wins over the extension */
+	BOOST_CHECK (probe("WEBVTT\n", ".srt") == sub::SubtitleFormat::WEBVTT);
+}
+
+
+/** Check that files with the wrong extension are read correctly */
+BOOST_AUTO_TEST_CASE (reader_factory_misnamed_test)
+{
+	boost::filesystem::copy_file ("test/data/test.vtt", "build/test/misnamed_vtt.srt", boost::filesystem::copy_option::overwrite_if_exists);
+	auto vtt = sub::reader_factory ("build/test/misnamed_vtt.srt");
+	BOOST_REQUIRE (vtt);
+	BOOST_CHECK (dynamic_pointer_cast<sub::WebVTTReader>(vtt));
+	BOOST_CHECK_EQUAL (sub::collect<vector<sub::Subtitle>>(vtt->subtitles()).size(), 2U);
+
+	boost::filesystem::copy_file ("test/data/test2.srt", "build/test/misnamed_srt.txt", boost::filesystem::copy_option::overwrite_if_exists);
+	auto srt = sub::reader_factory ("build/test/misnamed_srt.txt");
+	BOOST_REQUIRE (srt);
+	BOOST_CHECK (dynamic_pointer_cast<sub::SubripReader>(srt));
+	BOOST_CHECK_EQUAL (sub::collect<vector<sub::Subtitle>>(srt->subtitles()).size(), 7U);
+
+	boost::filesystem::copy_file ("test/data/test.ssa", "build/test/misnamed_ssa.srt", boost::filesystem::copy_option::overwrite_if_exists);
+	auto ssa = sub::reader_factory ("build/test/misnamed_ssa.srt");
+	BOOST_REQUIRE (ssa);
+	BOOST_CHECK (dynamic_pointer_cast<sub::SSAReader>(ssa));
+
+	auto stl = sub::reader_factory ("test/data/test_text.stl");
+	BOOST_REQUIRE (stl);
+	BOOST_CHECK (dynamic_pointer_cast<sub::STLTextReader>(stl));
+	BOOST_CHECK_EQUAL (sub::collect<vector<sub::Subtitle>>(stl->subtitles()).size(), 2U);
+}
+
+
+/** Check that a file bigger than the part that the factory looks at is read correctly */
+BOOST_AUTO_TEST_CASE (reader_factory_large_file_test)
+{
+	boost::filesystem::path const path = "build/test/reader_factory_large_file_test.srt";
+	{
+		std::ofstream f (path.string());
+		for (int i = 0; i < 500; ++i) {
+			f << (i + 1) << "\n00:00:" << (i / 10 % 60 < 10 ? "0" : "") << (i / 10 % 60) << ",000 --> 00:00:01,000\nSubtitle " << i << "\n\n";
+		}
+	}
+
+	auto reader = sub::reader_factory (path);
+	BOOST_REQUIRE (reader);
+	auto subs = reader->subtitles ();
+	BOOST_REQUIRE_EQUAL (subs.size(), 500U);
+	BOOST_CHECK_EQUAL (subs[0].text, "Subtitle 0");
+	BOOST_CHECK_EQUAL (subs[499].text, "Subtitle 499");
+}
@@ -0,0 +1,112 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "collect.h"
+#include "line_source.h"
+#include "ssa_reader.h"
+#include "stl_text_reader.h"
+#include "subrip_reader.h"
+#include "subtitle.h"
+#include "web_vtt_reader.h"
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+
+using std::make_shared;
+using std::vector;
+
+
+/** Read everything from a streaming reader using next() and check that we get
+ *  the same as an eager reader of the same input.
+ */
+static void
+check_streaming (sub::Reader& eager, sub::Reader& streaming, size_t expected_subtitles)
+{
+	vector<sub::RawSubtitle> streamed;
+	while (auto s = streaming.next()) {
+		/* We should never be holding more than one cue's worth of subtitles */
+		BOOST_CHECK (streaming.subtitles().size() < 16);
+		streamed.push_back (*s);
+	}
+
+	BOOST_CHECK (!streaming.next());
+
+	auto a = sub::collect<vector<sub::Subtitle>>(eager.subtitles());
+	auto b = sub::collect<vector<sub::Subtitle>>(streamed);
+	BOOST_CHECK_EQUAL (a.size(), expected_subtitles);
+	BOOST_CHECK (a == b);
+}
+
+
+BOOST_AUTO_TEST_CASE (subrip_reader_streaming_test)
+{
+	sub::MappedLineSource source("test/data/test2.srt");
+	sub::SubripReader eager(source);
+	sub::SubripReader streaming(make_shared<sub::MappedLineSource>("test/data/test2.srt"));
+	check_streaming (eager, streaming, 7);
+}
+
+
+BOOST_AUTO_TEST_CASE (web_vtt_reader_streaming_test)
+{
+	sub::MappedLineSource source("test/data/test.vtt");
+	sub::WebVTTReader eager(source);
+	sub::WebVTTReader streaming(make_shared<sub::MappedLineSource>("test/data/test.vtt"));
+	check_streaming (eager, streaming, 2);
+}
+
+
+BOOST_AUTO_TEST_CASE (ssa_reader_streaming_test)
+{
+	sub::MappedLineSource source("test/data/test.ssa");
+	sub::SSAReader eager(source);
+	sub::SSAReader streaming(make_shared<sub::MappedLineSource>("test/data/test.ssa"));
+	check_streaming (eager, streaming, sub::collect<vector<sub::Subtitle>>(eager.subtitles()).size());
+	BOOST_CHECK (!eager.subtitles().empty());
+}
+
+
+BOOST_AUTO_TEST_CASE (stl_text_reader_streaming_test)
+{
+	std::ifstream file("test/data/test_text.stl");
+	sub::STLTextReader eager(file);
+	sub::STLTextReader streaming(make_shared<std::ifstream>("test/data/test_text.stl"));
+	check_streaming (eager, streaming, 2);
+}
+
+
+/** Check that a range-based for loop over a reader visits every subtitle */
+BOOST_AUTO_TEST_CASE (reader_range_for_test)
+{
+	sub::SubripReader reader(make_shared<sub::MemoryLineSource>(std::string(
+		"1\n00:00:01,000 --> 00:00:02,000\nHello\nworld\n\n"
+		"2\n00:00:03,000 --> 00:00:04,000\nGoodbye\n")));
+
+	vector<std::string> text;
+	for (auto const& i: reader) {
+		text.push_back (i.text);
+	}
+
+	BOOST_REQUIRE_EQUAL (text.size(), 3U);
+	BOOST_CHECK_EQUAL (text[0], "Hello");
+	BOOST_CHECK_EQUAL (text[1], "world");
+	BOOST_CHECK_EQUAL (text[2], "Goodbye");
+}
@@ -0,0 +1,187 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "exceptions.h"
+#include "raw_subtitle.h"
+#include "raw_subtitle_track.h"
+#include "retime.h"
+#include "subtitle.h"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+
+using std::vector;
+
+
+static sub::RawSubtitle
+fragment (sub::Time from, sub::Time to)
+{
+	sub::RawSubtitle r;
+	r.text = "Hello";
+	r.from = from;
+	r.to = to;
+	r.vertical_position.line = 0;
+	r.vertical_position.reference = sub::TOP_OF_SUBTITLE;
+	return r;
+}
+
+
+BOOST_AUTO_TEST_CASE (retime_shift_test)
+{
+	vector<sub::RawSubtitle> subs = {
+		fragment (sub::Time::from_hms(10, 0, 1, 0), sub::Time::from_hms(10, 0, 2, 500)),
+		fragment (sub::Time::from_hms(10, 1, 0, 0), sub::Time::from_hms(10, 1, 3, 0))
+	};
+	subs[0].fade_up = sub::Time::from_hms (0, 0, 0, 200);
+
+	sub::retime (subs, sub::Transform::shift(sub::Time::from_hms(10, 0, 0, 0), sub::Time()));
+
+	BOOST_CHECK_EQUAL (subs[0].from, sub::Time::from_hms(0, 0, 1, 0));
+	BOOST_CHECK_EQUAL (subs[0].to, sub::Time::from_hms(0, 0, 2, 500));
+	BOOST_CHECK_EQUAL (subs[1].from, sub::Time::from_hms(0, 1, 0, 0));
+	BOOST_CHECK_EQUAL (subs[1].to, sub::Time::from_hms(0, 1, 3, 0));
+	BOOST_CHECK_EQUAL (subs[0].fade_up.get(), sub::Time::from_hms(0, 0, 0, 200));
+}
+
+
+/** Check that every frame at 24000/1001 becomes exactly the same frame at 25 after a PAL speed-up */
+BOOST_AUTO_TEST_CASE (retime_change_rate_test)
+{
+	sub::Rational const ntsc (24000, 1001);
+	sub::Rational const pal (25, 1);
+	auto const transform = sub::Transform::change_rate (ntsc, pal);
+
+	vector<sub::Time> times;
+	for (int i = 0; i < 1000000; i += 7) {
+		times.push_back (sub::Time::from_hmsf(0, 0, 0, i, ntsc));
+	}
+
+	transform.apply (times.data(), times.size());
+
+	for (size_t i = 0; i < times.size(); ++i) {
+		BOOST_REQUIRE_EQUAL (times[i], sub::Time::from_hmsf(0, 0, 0, i * 7, pal));
+	}
+	BOOST_CHECK (times[1].rate().get() == pal);
+}
+
+
+/** Check correction of drift, and that a track and a vector are retimed the same way */
+BOOST_AUTO_TEST_CASE (retime_map_test)
+{
+	vector<sub::RawSubtitle> subs;
+	sub::RawSubtitleTrack track;
+	for (int i = 0; i < 1000; ++i) {
+		auto f = fragment (sub::Time::from_hms(0, 0, i * 2, 0), sub::Time::from_hms(0, 0, i * 2 + 1, 0));
+		if (i % 10 == 0) {
+			f.fade_down = sub::Time::from_hms (0, 0, 0, 100);
+		}
+		subs.push_back (f);
+		track.push_back (f);
+	}
+
+	/* Subtitles start 1s late and are 1s further behind for every 1000s */
+	auto const transform = sub::Transform::map (
+		sub::Time::from_hms(0, 0, 1, 0), sub::Time(),
+		sub::Time::from_hms(0, 0, 1002, 0), sub::Time::from_hms(0, 0, 1000, 0)
+		);
+
+	BOOST_CHECK_EQUAL (transform(sub::Time::from_hms(0, 0, 501, 500)), sub::Time::from_hms(0, 0, 500, 0));
+
+	sub::retime (subs, transform);
+	sub::retime (track, transform);
+
+	/* -1s * 1000 / 1001, rounded to the nearest tick */
+	BOOST_CHECK_EQUAL (subs[0].from.ticks(), -704895105);
+	for (size_t i = 0; i < subs.size(); ++i) {
+		BOOST_REQUIRE_EQUAL (subs[i].from, track.from(i));
+		BOOST_REQUIRE_EQUAL (subs[i].to, track.to(i));
+		BOOST_REQUIRE (subs[i].fade_down == track.fade_down(i));
+	}
+	/* Fades are only scaled */
+	BOOST_CHECK_EQUAL (track.fade_down(10).get().ticks(), 70489510);
+}
+
+
+/** Check that times without a rate can only be shifted by whole seconds, as their frames are not real ticks */
+BOOST_AUTO_TEST_CASE (retime_rateless_test)
+{
+	auto const t = sub::Time::from_hmsf (0, 0, 10, 12);
+
+	auto const shifted = sub::Transform::shift(sub::Time::from_hms(0, 0, 5, 0), sub::Time())(t);
+	BOOST_CHECK_EQUAL (shifted, sub::Time::from_hmsf(0, 0, 5, 12));
+	BOOST_CHECK (!shifted.rate());
+
+	BOOST_CHECK_THROW (sub::Transform::shift(sub::Time::from_hms(0, 0, 0, 500), sub::Time())(t), sub::UnknownFrameRateError);
+	BOOST_CHECK_THROW (sub::Transform::change_rate(sub::Rational(24, 1), sub::Rational(25, 1))(t), sub::UnknownFrameRateError);
+	BOOST_CHECK_THROW (sub::Transform::change_rate(sub::Rational(24, 1), sub::Rational(25, 1)).scale(t), sub::UnknownFrameRateError);
+
+	vector<sub::RawSubtitle> subs = { fragment (t, sub::Time::from_hmsf(0, 0, 11, 3)) };
+	BOOST_CHECK_THROW (sub::retime(subs, sub::Transform::change_rate(sub::Rational(24, 1), sub::Rational(25, 1))), sub::UnknownFrameRateError);
+
+	sub::RawSubtitleTrack track;
+	track.push_back (subs[0]);
+	BOOST_CHECK_THROW (sub::retime(track, sub::Transform::change_rate(sub::Rational(24, 1), sub::Rational(25, 1))), sub::UnknownFrameRateError);
+	sub::retime (track, sub::Transform::shift(sub::Time::from_hms(0, 0, 10, 0), sub::Time()));
+	BOOST_CHECK_EQUAL (track.from(0), sub::Time::from_hmsf(0, 0, 0, 12));
+}
+
+
+static void
+check_unchanged (vector<sub::RawSubtitle> const& subs, vector<sub::RawSubtitle> const& original)
+{
+	BOOST_REQUIRE_EQUAL (subs.size(), original.size());
+	for (size_t i = 0; i < subs.size(); ++i) {
+		BOOST_CHECK_EQUAL (subs[i].from, original[i].from);
+		BOOST_CHECK_EQUAL (subs[i].to, original[i].to);
+		BOOST_CHECK (subs[i].fade_up == original[i].fade_up);
+		BOOST_CHECK (subs[i].fade_down == original[i].fade_down);
+	}
+}
+
+
+/** Check that a retime which fails because of a time without a rate leaves everything as it was */
+BOOST_AUTO_TEST_CASE (retime_rateless_unchanged_test)
+{
+	auto const rate = sub::Rational (24, 1);
+	auto const change = sub::Transform::change_rate (sub::Rational(24, 1), sub::Rational(25, 1));
+
+	vector<sub::RawSubtitle> subs;
+	subs.push_back (fragment(sub::Time::from_hmsf(0, 0, 1, 0, rate), sub::Time::from_hmsf(0, 0, 2, 0, rate)));
+	subs.push_back (fragment(sub::Time::from_hmsf(0, 0, 3, 0, rate), sub::Time::from_hmsf(0, 0, 4, 0)));
+	subs.push_back (fragment(sub::Time::from_hmsf(0, 0, 5, 0, rate), sub::Time::from_hmsf(0, 0, 6, 0, rate)));
+	subs[2].fade_up = sub::Time::from_hmsf (0, 0, 0, 12);
+
+	sub::RawSubtitleTrack track;
+	for (auto const& i: subs) {
+		track.push_back (i);
+	}
+
+	auto const original = subs;
+	BOOST_CHECK_THROW (sub::retime(subs, change), sub::UnknownFrameRateError);
+	check_unchanged (subs, original);
+
+	BOOST_CHECK_THROW (sub::retime(track, change), sub::UnknownFrameRateError);
+	check_unchanged (track.subtitles(), original);
+
+	/* Just a fade without a rate is enough to stop anything being changed */
+	subs[1].to = sub::Time::from_hmsf (0, 0, 4, 0, rate);
+	auto const original_with_rates = subs;
+	BOOST_CHECK_THROW (sub::retime(subs, change), sub::UnknownFrameRateError);
+	check_unchanged (subs, original_with_rates);
+}
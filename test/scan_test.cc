@@ -0,0 +1,97 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "scan.h"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <random>
+#include <string>
+
+
+using std::string;
+
+
+/** Check every implementation against std::find_first_of for many lengths and
+ *  alignments, including delimiters in the last block and in the part of the
+ *  last block which overlaps the one before.
+ */
+BOOST_AUTO_TEST_CASE (find_first_of_test)
+{
+	std::mt19937 random (42);
+	string const alphabet = "abc<{\\,|^\n\xe2\x80\xa8";
+
+	string buffer (256, ' ');
+	for (auto& i: buffer) {
+		i = alphabet[random() % alphabet.size()];
+	}
+
+	for (string const bytes: { "<", "<{", "{\\\r\n", "|^", ",\n\xe2", "<{\\,|^\n\xe2" }) {
+		sub::ByteSet const set (bytes);
+		/* Sparse input, so that there are long runs with nothing in the set */
+		string sparse (buffer.size(), 'x');
+		for (size_t i = 0; i < sparse.size(); i += 37) {
+			sparse[i] = buffer[i];
+		}
+
+		for (auto const& input: { buffer, sparse }) {
+			for (size_t start = 0; start < 40; ++start) {
+				for (size_t end = start; end < input.size(); end += 3) {
+					auto const begin_ptr = input.data() + start;
+					auto const end_ptr = input.data() + end;
+					auto const expected = std::find_first_of (begin_ptr, end_ptr, bytes.begin(), bytes.end());
+					for (auto i: sub::scan_implementations()) {
+						BOOST_REQUIRE_MESSAGE (
+							sub::find_first_of(i, begin_ptr, end_ptr, set) == expected,
+							sub::scan_implementation_name(i) << " " << start << " " << end
+							);
+					}
+					BOOST_REQUIRE (sub::find_first_of(begin_ptr, end_ptr, set) == expected);
+				}
+			}
+		}
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE (byte_set_test)
+{
+	sub::ByteSet set ("abca");
+	BOOST_CHECK_EQUAL (set.size(), 3);
+	BOOST_CHECK (set.contains('c'));
+	BOOST_CHECK (!set.contains('d'));
+
+	string const text = "xxxx";
+	BOOST_CHECK (sub::find_first_of(text.data(), text.data() + text.size(), sub::ByteSet("")) == text.data() + text.size());
+}
+
+
+BOOST_AUTO_TEST_CASE (find_line_separator_test)
+{
+	auto find = [](string const& s) {
+		return sub::find_line_separator(s.data(), s.data() + s.size()) - s.data();
+	};
+
+	BOOST_CHECK_EQUAL (find(""), 0);
+	BOOST_CHECK_EQUAL (find("hello"), 5);
+	BOOST_CHECK_EQUAL (find("hello\xe2\x80\xa8world"), 5);
+	/* U+202B starts with the same byte */
+	BOOST_CHECK_EQUAL (find("\xe2\x80\xab" "a\xe2\x80\xa8"), 4);
+	/* Truncated separator at the end */
+	BOOST_CHECK_EQUAL (find("ab\xe2\x80"), 4);
+}
@@ -18,6 +18,8 @@
 */
 
 
+#include "collect.h"
+#include "reader_factory.h"
 #include "stl_binary_reader.h"
 #include "subtitle.h"
 #include "test.h"
@@ -131,3 +133,44 @@ BOOST_AUTO_TEST_CASE(stl_binary_reader_with_colour)
 	}
 }
 
+/** Read a binary STL file a TTI block at a time */
+BOOST_AUTO_TEST_CASE (stl_binary_reader_streaming_test)
+{
+	boost::filesystem::path const path = "build/test/stl_binary_reader_streaming_test.stl";
+	write_test_stl (path);
+
+	std::ifstream file (path.string().c_str(), std::ios::binary);
+	sub::STLBinaryReader eager (file);
+
+	sub::STLBinaryReader streaming (std::make_shared<std::ifstream>(path.string().c_str(), std::ios::binary));
+	vector<sub::RawSubtitle> streamed;
+	for (auto const& i: streaming) {
+		streamed.push_back (i);
+	}
+
+	auto a = sub::collect<vector<sub::Subtitle>> (eager.subtitles());
+	auto b = sub::collect<vector<sub::Subtitle>> (streamed);
+	BOOST_CHECK_EQUAL (a.size(), 2U);
+	BOOST_CHECK (a == b);
+}
+
+/** Check that reader_factory finds a binary STL file to be binary STL, and that the reader
+ *  copes with being given the bytes that the factory has already read.
+ */
+BOOST_AUTO_TEST_CASE (stl_binary_reader_factory_test)
+{
+	boost::filesystem::path const path = "build/test/stl_binary_reader_factory_test.stl";
+	write_test_stl (path);
+
+	std::ifstream file (path.string().c_str(), std::ios::binary);
+	sub::STLBinaryReader direct (file);
+
+	auto factory = sub::reader_factory (path);
+	BOOST_REQUIRE (factory);
+	BOOST_CHECK (std::dynamic_pointer_cast<sub::STLBinaryReader>(factory));
+
+	auto a = sub::collect<vector<sub::Subtitle>> (direct.subtitles());
+	auto b = sub::collect<vector<sub::Subtitle>> (factory->subtitles());
+	BOOST_CHECK_EQUAL (a.size(), 2U);
+	BOOST_CHECK (a == b);
+}
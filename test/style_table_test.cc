@@ -0,0 +1,99 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "collect.h"
+#include "line_source.h"
+#include "raw_subtitle_track.h"
+#include "ssa_reader.h"
+#include "style_table.h"
+#include "subrip_reader.h"
+#include "subtitle.h"
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <vector>
+
+
+using std::vector;
+
+
+BOOST_AUTO_TEST_CASE (style_table_test)
+{
+	sub::Style a;
+	a.font = "Arial";
+	sub::Style b = a;
+	b.italic = true;
+	sub::Style c = a;
+	c.colour = sub::Colour (1, 0, 0);
+
+	sub::StyleTable table;
+	BOOST_CHECK_EQUAL (table.intern(a), 0U);
+	BOOST_CHECK_EQUAL (table.intern(b), 1U);
+	BOOST_CHECK_EQUAL (table.intern(a), 0U);
+	BOOST_CHECK_EQUAL (table.intern(c), 2U);
+	BOOST_CHECK_EQUAL (table.intern(b), 1U);
+	BOOST_CHECK_EQUAL (table.size(), 3U);
+	BOOST_CHECK (table[1] == b);
+	BOOST_CHECK (table[2] != a);
+
+	sub::Style d = a;
+	d.font = "Helvetica";
+	BOOST_CHECK_EQUAL (table.intern(d), 3U);
+	d.font = boost::none;
+	BOOST_CHECK_EQUAL (table.intern(d), 4U);
+	BOOST_CHECK_EQUAL (table.intern(sub::Style()), 4U);
+}
+
+
+static void
+check_collect (sub::Reader& reader)
+{
+	auto const subs = reader.subtitles ();
+	sub::RawSubtitleTrack track;
+	for (auto const& i: subs) {
+		track.push_back (i);
+	}
+
+	auto a = sub::collect<vector<sub::Subtitle>> (subs);
+	auto b = sub::collect<vector<sub::Subtitle>> (track);
+	BOOST_CHECK (!a.empty());
+	BOOST_CHECK (a == b);
+}
+
+
+/** Check that collecting a track gives the same as collecting RawSubtitles */
+BOOST_AUTO_TEST_CASE (collect_track_test)
+{
+	{
+		sub::MappedLineSource source ("test/data/test.ssa");
+		sub::SSAReader reader (source);
+		check_collect (reader);
+	}
+
+	{
+		sub::MappedLineSource source ("test/data/test.srt");
+		sub::SubripReader reader (source);
+		check_collect (reader);
+	}
+
+	{
+		sub::MappedLineSource source ("test/data/test2.srt");
+		sub::SubripReader reader (source);
+		check_collect (reader);
+	}
+}
@@ -17,16 +17,19 @@
 
 */
 
+#include "raw_subtitle_track.h"
 #include "subrip_reader.h"
 #include "subtitle.h"
 #include "test.h"
 #include "exceptions.h"
 #include "collect.h"
+#include "line_source.h"
 #include <boost/test/unit_test.hpp>
 #include <boost/filesystem.hpp>
 #include <cmath>
 #include <iostream>
 #include <cstdio>
+#include <list>
 
 using std::cerr;
 using std::vector;
@@ -424,6 +427,29 @@ BOOST_AUTO_TEST_CASE (subrip_reader_convert_line_test)
 	i = r._subs.begin ();
 	BOOST_CHECK_EQUAL (i->text, "<< angle brackets but no HTML >>");
 	r._subs.clear();
+
+	rs = sub::RawSubtitle();
+	r.convert_line(0, "<FONT COLOR=\"#ff0000\" color='#00ff00'>green</Font></font>white", rs);
+	BOOST_CHECK_EQUAL (r._subs.size(), 2U);
+	i = r._subs.begin ();
+	BOOST_CHECK_EQUAL (i->text, "green");
+	BOOST_CHECK (fabs (i->colour.r) < 0.01);
+	BOOST_CHECK_CLOSE (i->colour.g, 1, 0.1);
+	++i;
+	/* An unmatched </font> leaves the default colour */
+	BOOST_CHECK_EQUAL (i->text, "white");
+	BOOST_CHECK (i->colour == sub::Colour(1, 1, 1));
+	r._subs.clear();
+
+	rs = sub::RawSubtitle();
+	r.convert_line(0, "<font color=\"rgba( 255, 0 ,128, 0)\">pink</font>", rs);
+	BOOST_CHECK_EQUAL (r._subs.size(), 1U);
+	BOOST_CHECK_CLOSE (r._subs.front().colour.r, 1, 0.1);
+	BOOST_CHECK_CLOSE (r._subs.front().colour.b, 128 / 255.0, 0.1);
+	r._subs.clear();
+
+	rs = sub::RawSubtitle();
+	BOOST_CHECK_THROW (r.convert_line(0, "<font color=\"#12345\">bad</font>", rs), sub::SubripError);
 }
 
 /** Test SubripReader::convert_time */
@@ -746,3 +772,230 @@ BOOST_AUTO_TEST_CASE(subrip_tolerates_extra_font_closing_tags)
 	fclose(f);
 }
 
+
+
+static void
+write_many_cues (boost::filesystem::path path, int cues, int bad_cue = -1)
+{
+	auto f = fopen(path.string().c_str(), "w");
+	BOOST_REQUIRE(f);
+	for (int i = 0; i < cues; ++i) {
+		int const s = i * 2;
+		fprintf(f, "%d\r\n", i + 1);
+		if (i == bad_cue) {
+			fprintf(f, "00:%02d:xx,000 --> 00:%02d:%02d,500\r\n", s / 60 % 60, s / 60 % 60, s % 60);
+		} else {
+			fprintf(f, "%02d:%02d:%02d,000 --> %02d:%02d:%02d,500\r\n", s / 3600, s / 60 % 60, s % 60, s / 3600, s / 60 % 60, s % 60);
+		}
+		fprintf(f, "Subtitle <i>number</i> %d\r\nwith a second line\r\n\r\n", i + 1);
+	}
+	fclose(f);
+}
+
+
+BOOST_AUTO_TEST_CASE(subrip_reader_split_points_test)
+{
+	std::string const srt =
+		"1\n00:00:01,000 --> 00:00:02,000\nOne\n\n"
+		"2\r\n00:00:03,000 --> 00:00:04,000\r\nTwo\r\n\r\n"
+		"Not a counter\n00:00:05,000 --> 00:00:06,000\nThree\n\n"
+		"4\n00:00:07,000 --> 00:00:08,000\nFour\n";
+
+	auto points = sub::SubripReader::split_points(srt.data(), srt.size(), 1);
+	BOOST_REQUIRE_EQUAL(points.size(), 4U);
+	BOOST_CHECK_EQUAL(points[0], 0U);
+	BOOST_CHECK_EQUAL(srt.substr(points[1], 3), "2\r\n");
+	BOOST_CHECK_EQUAL(srt.substr(points[2], 2), "4\n");
+	BOOST_CHECK_EQUAL(points[3], srt.size());
+
+	points = sub::SubripReader::split_points(srt.data(), srt.size(), srt.size());
+	BOOST_CHECK_EQUAL(points.size(), 2U);
+}
+
+
+/** Check that parallel reading gives the same as serial */
+BOOST_AUTO_TEST_CASE(subrip_reader_parallel_test)
+{
+	boost::filesystem::path const path = "build/test/subrip_reader_parallel_test.srt";
+	write_many_cues(path, 20000);
+
+	sub::MappedLineSource source(path);
+	sub::SubripReader serial(source);
+	sub::SubripReader parallel(path, 4);
+
+	auto a = serial.subtitles();
+	auto b = parallel.subtitles();
+	BOOST_REQUIRE_EQUAL(a.size(), 80000U);
+	BOOST_REQUIRE_EQUAL(a.size(), b.size());
+	BOOST_CHECK(sub::collect<std::vector<sub::Subtitle>>(a) == sub::collect<std::vector<sub::Subtitle>>(b));
+}
+
+
+/** Check that errors found when reading in parallel are the same as they would be when reading serially */
+BOOST_AUTO_TEST_CASE(subrip_reader_parallel_error_test)
+{
+	boost::filesystem::path const path = "build/test/subrip_reader_parallel_error_test.srt";
+	write_many_cues(path, 20000, 15000);
+
+	int serial_line = 0;
+	std::list<std::string> serial_context;
+	try {
+		sub::MappedLineSource source(path);
+		sub::SubripReader reader(source);
+	} catch (sub::SubripError& e) {
+		serial_line = e.line_number();
+		serial_context = e.context();
+	}
+
+	BOOST_CHECK_EQUAL(serial_line, 15000 * 5 + 2);
+
+	int parallel_line = 0;
+	std::list<std::string> parallel_context;
+	try {
+		sub::SubripReader reader(path, 4);
+	} catch (sub::SubripError& e) {
+		parallel_line = e.line_number();
+		parallel_context = e.context();
+	}
+
+	BOOST_CHECK_EQUAL(serial_line, parallel_line);
+	BOOST_CHECK(serial_context == parallel_context);
+}
+
+
+/** Check that collecting from an rvalue (which moves the fragments) gives the same result as collecting from a copy */
+BOOST_AUTO_TEST_CASE(subrip_reader_collect_move_test)
+{
+	sub::MappedLineSource source("test/data/test2.srt");
+	sub::SubripReader reader(source);
+
+	auto raw = reader.subtitles();
+	auto copied = sub::collect<vector<sub::Subtitle>>(raw);
+	auto moved = sub::collect<vector<sub::Subtitle>>(std::move(raw));
+
+	BOOST_CHECK_EQUAL(copied.size(), 7U);
+	BOOST_CHECK(copied == moved);
+}
+
+
+static std::string const subrip_with_bad_cues =
+	"1\n00:00:01,000 --> 00:00:02,000\nOne\n\n"
+	/* A bad time, and no blank line after the cue */
+	"2\n00:00:03,000 --> 00:00:0x,000\nTwo\n"
+	"3\n00:00:05,000 --> 00:00:06,000\nThree\n\n"
+	/* A bad colour */
+	"4\n00:00:07,000 --> 00:00:08,000\n<font color=\"#12\">Four</font>\nmore four\n\n"
+	"5\n00:00:09,000 --> 00:00:10,000\nFive\n";
+
+
+/** Check that bad cues can be skipped, with a diagnostic for each */
+BOOST_AUTO_TEST_CASE(subrip_reader_skip_cue_test)
+{
+	{
+		sub::MemoryLineSource source(subrip_with_bad_cues.data(), subrip_with_bad_cues.size());
+		BOOST_CHECK_THROW(sub::SubripReader reader(source), sub::SubripError);
+	}
+
+	auto diagnostics = std::make_shared<sub::CollectingDiagnosticSink>();
+	sub::MemoryLineSource source(subrip_with_bad_cues.data(), subrip_with_bad_cues.size());
+	sub::SubripReader reader(source, diagnostics, sub::ErrorPolicy::SKIP_CUE);
+
+	auto const subs = reader.subtitles();
+	BOOST_REQUIRE_EQUAL(subs.size(), 3U);
+	BOOST_CHECK_EQUAL(subs[0].text, "One");
+	BOOST_CHECK_EQUAL(subs[1].text, "Three");
+	BOOST_CHECK_EQUAL(subs[1].from, sub::Time::from_hms(0, 0, 5, 0));
+	BOOST_CHECK_EQUAL(subs[2].text, "Five");
+
+	auto const reported = diagnostics->diagnostics();
+	BOOST_REQUIRE_EQUAL(reported.size(), 2U);
+	BOOST_CHECK(reported[0].code == sub::DiagnosticCode::BAD_CUE);
+	BOOST_CHECK(reported[0].severity == sub::DiagnosticSeverity::ERROR);
+	BOOST_CHECK_EQUAL(reported[0].line.get(), 6);
+	BOOST_CHECK_EQUAL(reported[0].offset.get(), 39);
+	BOOST_CHECK_EQUAL(reported[1].line.get(), 14);
+}
+
+
+/** Check that a cue which goes wrong part of the way through gives nothing, even the
+ *  lines and text that came before the error.
+ */
+BOOST_AUTO_TEST_CASE(subrip_reader_skip_partial_cue_test)
+{
+	std::string const subrip =
+		"1\n00:00:01,000 --> 00:00:02,000\nFirst line\nBad <font color=\"zz\">x</font>\n\n"
+		"2\n00:00:03,000 --> 00:00:04,000\nGood\n";
+
+	{
+		auto diagnostics = std::make_shared<sub::CollectingDiagnosticSink>();
+		sub::MemoryLineSource source(subrip.data(), subrip.size());
+		sub::SubripReader reader(source, diagnostics, sub::ErrorPolicy::SKIP_CUE);
+
+		auto const subs = reader.subtitles();
+		BOOST_REQUIRE_EQUAL(subs.size(), 1U);
+		BOOST_CHECK_EQUAL(subs[0].text, "Good");
+		BOOST_REQUIRE_EQUAL(diagnostics->diagnostics().size(), 1U);
+		BOOST_CHECK_EQUAL(diagnostics->diagnostics()[0].line.get(), 4);
+	}
+
+	{
+		/* This reader reads as it goes, straight into the track */
+		sub::SubripReader reader(std::make_shared<sub::MemoryLineSource>(subrip));
+		reader.set_error_policy(sub::ErrorPolicy::SKIP_CUE);
+		sub::RawSubtitleTrack track;
+		reader.read(track);
+		BOOST_REQUIRE_EQUAL(track.size(), 1U);
+		BOOST_CHECK_EQUAL(track.text(0), "Good");
+	}
+}
+
+
+/** Check that the context of an error is recalled correctly from a FileLineSource
+ *  which has had to move its data around.
+ */
+BOOST_AUTO_TEST_CASE(subrip_reader_file_error_context_test)
+{
+	boost::filesystem::path const path = "build/test/subrip_reader_file_error_context_test.srt";
+	auto f = fopen(path.string().c_str(), "wb");
+	BOOST_REQUIRE(f);
+	fwrite(subrip_with_bad_cues.data(), 1, subrip_with_bad_cues.size(), f);
+	fclose(f);
+
+	std::list<std::string> context;
+	f = fopen(path.string().c_str(), "rb");
+	BOOST_REQUIRE(f);
+	try {
+		sub::FileLineSource source(f, 16);
+		sub::SubripReader reader(source);
+	} catch (sub::SubripError& e) {
+		context = e.context();
+	}
+	fclose(f);
+
+	std::list<std::string> const expected = { "00:00:01,000 --> 00:00:02,000", "One", "", "2", "00:00:03,000 --> 00:00:0x,000" };
+	BOOST_CHECK(context == expected);
+}
+
+
+/** Check that skipping bad cues when reading in parallel gives the same result as when reading serially */
+BOOST_AUTO_TEST_CASE(subrip_reader_parallel_skip_cue_test)
+{
+	boost::filesystem::path const path = "build/test/subrip_reader_parallel_skip_cue_test.srt";
+	write_many_cues(path, 20000, 15000);
+
+	auto serial_diagnostics = std::make_shared<sub::CollectingDiagnosticSink>();
+	sub::MappedLineSource source(path);
+	sub::SubripReader serial(source, serial_diagnostics, sub::ErrorPolicy::SKIP_CUE);
+
+	auto parallel_diagnostics = std::make_shared<sub::CollectingDiagnosticSink>();
+	sub::SubripReader parallel(path, 4, parallel_diagnostics, sub::ErrorPolicy::SKIP_CUE);
+
+	auto a = serial.subtitles();
+	auto b = parallel.subtitles();
+	BOOST_CHECK_EQUAL(a.size(), 19999U * 4);
+	BOOST_CHECK(sub::collect<std::vector<sub::Subtitle>>(a) == sub::collect<std::vector<sub::Subtitle>>(b));
+	BOOST_REQUIRE_EQUAL(serial_diagnostics->diagnostics().size(), 1U);
+	BOOST_REQUIRE_EQUAL(parallel_diagnostics->diagnostics().size(), 1U);
+	BOOST_CHECK_EQUAL(serial_diagnostics->diagnostics()[0].line.get(), 15000 * 5 + 2);
+	BOOST_CHECK_EQUAL(parallel_diagnostics->diagnostics()[0].line.get(), 15000 * 5 + 2);
+}
@@ -0,0 +1,101 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "collect.h"
+#include "line_source.h"
+#include "subrip_reader.h"
+#include "subrip_writer.h"
+#include "subtitle.h"
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+using std::string;
+using std::vector;
+
+
+static string
+read_file (boost::filesystem::path path)
+{
+	std::ifstream in(path.string().c_str(), std::ios::binary);
+	return string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+
+static string
+round_trip (string const& subrip)
+{
+	sub::SubripReader reader(subrip);
+	std::ostringstream out;
+	sub::write_subrip(sub::collect<vector<sub::Subtitle>>(reader.subtitles()), out);
+	return out.str();
+}
+
+
+/** Check that reading and then writing these files gives exactly what we started with */
+BOOST_AUTO_TEST_CASE(subrip_writer_round_trip_test)
+{
+	for (auto name: { "test2.srt", "test3.srt" }) {
+		BOOST_TEST_CONTEXT(name) {
+			auto const original = read_file(boost::filesystem::path("test/data") / name);
+			BOOST_CHECK_EQUAL(round_trip(original), original);
+		}
+	}
+}
+
+
+/** Some files are not written the way that we would write them (test.srt has badly-nested
+ *  tags and newline.srt uses a Unicode line separator), so check that after one round trip
+ *  we have the same subtitles and then the output is stable.
+ */
+BOOST_AUTO_TEST_CASE(subrip_writer_stable_test)
+{
+	for (auto name: { "test.srt", "newline.srt" }) {
+		BOOST_TEST_CONTEXT(name) {
+			sub::SubripReader reader(read_file(boost::filesystem::path("test/data") / name));
+			auto const subs = sub::collect<vector<sub::Subtitle>>(reader.subtitles());
+
+			std::ostringstream out;
+			sub::write_subrip(subs, out);
+			sub::SubripReader again(out.str());
+			BOOST_CHECK(sub::collect<vector<sub::Subtitle>>(again.subtitles()) == subs);
+			BOOST_CHECK_EQUAL(round_trip(out.str()), out.str());
+		}
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(subrip_writer_tags_test)
+{
+	string const original =
+		"1\n"
+		"00:00:01,000 --> 00:00:02,500\n"
+		"<b>Bold <i>and italic</i></b> then <font color=\"#ff8000\">orange <u>underlined</u></font>\n"
+		"<i>Italic</i> on the next line\n"
+		"\n"
+		"2\n"
+		"01:00:00,000 --> 123:00:00,007\n"
+		"{\\an9}Top right\n";
+
+	BOOST_CHECK_EQUAL(round_trip(original), original);
+}
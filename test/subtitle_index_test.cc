@@ -0,0 +1,118 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "subtitle_index.h"
+#include <boost/test/unit_test.hpp>
+#include <cstdlib>
+#include <vector>
+
+
+using std::vector;
+
+
+static sub::Subtitle
+subtitle (int from, int to)
+{
+	sub::Subtitle s;
+	s.from = sub::Time::from_hms (0, 0, from / 1000, from % 1000);
+	s.to = sub::Time::from_hms (0, 0, to / 1000, to % 1000);
+	return s;
+}
+
+
+static sub::Time
+ms (int t)
+{
+	return sub::Time::from_hms (0, 0, t / 1000, t % 1000);
+}
+
+
+/** Find the subtitles on screen between from and to by looking at all of them */
+static vector<size_t>
+scan (sub::SubtitleIndex const& index, sub::Time from, sub::Time to)
+{
+	vector<size_t> out;
+	for (size_t i = 0; i < index.size(); ++i) {
+		if (index[i].from < to && index[i].to > from) {
+			out.push_back (i);
+		}
+	}
+	return out;
+}
+
+
+BOOST_AUTO_TEST_CASE (subtitle_index_test)
+{
+	vector<sub::Subtitle> subs = {
+		subtitle (5000, 6000),
+		subtitle (1000, 2000),
+		subtitle (1500, 9000),
+		subtitle (2000, 3000)
+	};
+
+	sub::SubtitleIndex index (subs);
+	BOOST_REQUIRE_EQUAL (index.size(), 4U);
+	BOOST_CHECK (index[0].from == ms(1000));
+	BOOST_CHECK (index[3].from == ms(5000));
+
+	BOOST_CHECK (index.at(ms(0)).empty());
+	BOOST_CHECK (index.at(ms(1000)) == vector<size_t>({0}));
+	BOOST_CHECK (index.at(ms(1999)) == vector<size_t>({0, 1}));
+	BOOST_CHECK (index.at(ms(2000)) == vector<size_t>({1, 2}));
+	BOOST_CHECK (index.at(ms(5500)) == vector<size_t>({1, 3}));
+	BOOST_CHECK (index.at(ms(9000)).empty());
+
+	BOOST_CHECK (index.between(ms(3000), ms(5000)) == vector<size_t>({1}));
+	BOOST_CHECK (index.between(ms(0), ms(1001)) == vector<size_t>({0}));
+
+	BOOST_CHECK (sub::SubtitleIndex(vector<sub::Subtitle>()).at(ms(0)).empty());
+}
+
+
+/** Compare the results of queries and of playback with a brute-force search */
+BOOST_AUTO_TEST_CASE (subtitle_index_random_test)
+{
+	srand (1);
+
+	vector<sub::Subtitle> subs;
+	for (int i = 0; i < 2000; ++i) {
+		int const from = rand() % 600000;
+		int const length = (rand() % 10 == 0) ? rand() % 100000 : rand() % 5000 + 1;
+		subs.push_back (subtitle(from, from + length));
+	}
+
+	sub::SubtitleIndex index (subs);
+
+	for (int i = 0; i < 500; ++i) {
+		auto const t = rand() % 700000;
+		BOOST_REQUIRE (index.at(ms(t)) == scan(index, ms(t), ms(t + 1)));
+		auto const from = rand() % 700000;
+		auto const to = from + rand() % 20000 + 1;
+		BOOST_REQUIRE (index.between(ms(from), ms(to)) == scan(index, ms(from), ms(to)));
+	}
+
+	sub::SubtitleIndex playback (subs);
+	for (int t = 0; t < 700000; t += 40) {
+		/* Seek back now and again */
+		if (t % 100000 == 0 && t > 0) {
+			BOOST_REQUIRE (playback.advance(ms(t - 50000)) == playback.at(ms(t - 50000)));
+		}
+		BOOST_REQUIRE (playback.advance(ms(t)) == playback.at(ms(t)));
+	}
+}
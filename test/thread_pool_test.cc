@@ -0,0 +1,113 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "exceptions.h"
+#include "reader.h"
+#include "reader_factory.h"
+#include "thread_pool.h"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+
+using std::function;
+using std::vector;
+
+
+BOOST_AUTO_TEST_CASE (thread_pool_test)
+{
+	sub::ThreadPool pool (4);
+	BOOST_CHECK_EQUAL (pool.threads(), 4);
+
+	/* Run twice to check that the pool can be re-used */
+	for (int run = 0; run < 2; ++run) {
+		vector<int> done (1000, 0);
+		std::atomic<int> total (0);
+		vector<function<void ()>> tasks;
+		for (size_t i = 0; i < done.size(); ++i) {
+			tasks.push_back ([&done, &total, i]() {
+				++done[i];
+				total += static_cast<int>(i);
+			});
+		}
+
+		pool.run (tasks);
+
+		BOOST_CHECK (std::all_of(done.begin(), done.end(), [](int d) { return d == 1; }));
+		BOOST_CHECK_EQUAL (total, 999 * 1000 / 2);
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE (thread_pool_exception_test)
+{
+	sub::ThreadPool pool (2);
+
+	std::atomic<int> count (0);
+	vector<function<void ()>> tasks;
+	for (int i = 0; i < 10; ++i) {
+		tasks.push_back ([&count, i]() {
+			++count;
+			if (i == 3) {
+				throw std::runtime_error ("oops");
+			}
+		});
+	}
+
+	BOOST_CHECK_THROW (pool.run(tasks), std::runtime_error);
+	/* Everything should still have been run */
+	BOOST_CHECK_EQUAL (count, 10);
+}
+
+
+/** Check that a bad file in a batch does not stop the others being read */
+BOOST_AUTO_TEST_CASE (reader_factory_batch_test)
+{
+	vector<boost::filesystem::path> files = {
+		"test/data/test.srt",
+		"test/data/does_not_exist.srt",
+		"test/data/test_text.stl",
+		"test/data/test.ssa",
+		"test/data/test2.srt",
+	};
+
+	auto results = sub::reader_factory (files, 3);
+	BOOST_REQUIRE_EQUAL (results.size(), files.size());
+
+	for (size_t i = 0; i < files.size(); ++i) {
+		BOOST_CHECK_EQUAL (results[i].file, files[i]);
+	}
+
+	BOOST_CHECK (results[0].reader);
+	BOOST_CHECK (!results[0].error);
+	BOOST_CHECK (!results[0].reader->subtitles().empty());
+
+	BOOST_CHECK (!results[1].reader);
+	BOOST_CHECK_THROW (std::rethrow_exception(results[1].error), sub::FileError);
+
+	BOOST_CHECK (results[2].reader);
+	BOOST_CHECK (!results[2].reader->subtitles().empty());
+
+	BOOST_CHECK (results[3].reader);
+	BOOST_CHECK (!results[3].error);
+
+	BOOST_CHECK (results[4].reader);
+}
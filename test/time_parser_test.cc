@@ -0,0 +1,117 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "exceptions.h"
+#include "time_formatter.h"
+#include "time_parser.h"
+#include <boost/test/unit_test.hpp>
+
+
+using sub::Time;
+using sub::TimeParseError;
+
+
+BOOST_AUTO_TEST_CASE (parse_time_test)
+{
+	auto r = sub::parse_time<sub::SubripTimeFormat>("01:02:03,456");
+	BOOST_REQUIRE (r);
+	BOOST_CHECK_EQUAL (r.time, Time::from_hms(1, 2, 3, 456));
+
+	r = sub::parse_time<sub::WebVTTTimeFormat>("00:00:10.5");
+	BOOST_REQUIRE (r);
+	BOOST_CHECK_EQUAL (r.time, Time::from_hms(0, 0, 10, 5));
+
+	r = sub::parse_time<sub::SSATimeFormat>("0:01:02.35");
+	BOOST_REQUIRE (r);
+	BOOST_CHECK_EQUAL (r.time, Time::from_hms(0, 1, 2, 350));
+
+	r = sub::parse_time<sub::STLTextTimeFormat>("00:00:01:12");
+	BOOST_REQUIRE (r);
+	BOOST_CHECK_EQUAL (r.time, Time::from_hmsf(0, 0, 1, 12));
+
+	/* Any number of digits, and signs, are accepted */
+	r = sub::parse_time<sub::SubripTimeFormat>("100:+2:-3,4");
+	BOOST_REQUIRE (r);
+	BOOST_CHECK_EQUAL (r.time, Time::from_hms(100, 2, -3, 4));
+
+	/* Only the given span is looked at */
+	char const text[] = "00:00:01,000 --> 00:00:02,000";
+	r = sub::parse_time<sub::SubripTimeFormat>(text, text + 12);
+	BOOST_REQUIRE (r);
+	BOOST_CHECK_EQUAL (r.time, Time::from_hms(0, 0, 1, 0));
+}
+
+
+BOOST_AUTO_TEST_CASE (parse_time_error_test)
+{
+	auto error = [](std::string t) {
+		return sub::parse_time<sub::SubripTimeFormat>(t).error;
+	};
+
+	BOOST_CHECK (error("") == TimeParseError::FORMAT);
+	BOOST_CHECK (error("00:00:01") == TimeParseError::FORMAT);
+	BOOST_CHECK (error("00:00:01.000") == TimeParseError::FORMAT);
+	BOOST_CHECK (error("00:00:00:01,000") == TimeParseError::FORMAT);
+	BOOST_CHECK (error("00:00:01,000,0") == TimeParseError::FORMAT);
+	BOOST_CHECK (error("0a:00:01,000") == TimeParseError::HOURS);
+	BOOST_CHECK (error("00::01,000") == TimeParseError::MINUTES);
+	BOOST_CHECK (error("00:00: 1,000") == TimeParseError::SECONDS);
+	BOOST_CHECK (error("00:00:01,") == TimeParseError::FRACTION);
+	BOOST_CHECK (error("00:00:01,-") == TimeParseError::FRACTION);
+	BOOST_CHECK (error("99999999999:00:01,000") == TimeParseError::HOURS);
+
+	BOOST_CHECK (sub::parse_time<sub::STLTextTimeFormat>("00:00:01").error == TimeParseError::FORMAT);
+	BOOST_CHECK (sub::parse_time<sub::STLTextTimeFormat>("00:00:01:02:03").error == TimeParseError::FORMAT);
+
+	BOOST_CHECK_EQUAL (sub::time_parse_expected<sub::SubripTimeFormat>(TimeParseError::FORMAT), "time in the format h:m:s,ms");
+	BOOST_CHECK_EQUAL (sub::time_parse_expected<sub::SSATimeFormat>(TimeParseError::FRACTION), "integer centisecond value");
+}
+
+
+BOOST_AUTO_TEST_CASE (format_time_test)
+{
+	std::string out;
+	sub::format_time<sub::SubripTimeFormat>(Time::from_hms(1, 2, 3, 456), out);
+	BOOST_CHECK_EQUAL (out, "01:02:03,456");
+
+	/* Rounding to the nearest millisecond, which may carry into the seconds */
+	out.clear ();
+	sub::format_time<sub::WebVTTTimeFormat>(Time::from_ticks(Time::ticks_per_second * 59 + Time::ticks_per_second * 9996 / 10000, sub::Rational(10000, 1)), out);
+	BOOST_CHECK_EQUAL (out, "00:01:00.000");
+
+	out.clear ();
+	sub::format_time<sub::WebVTTTimeFormat>(Time::from_hms(123, 0, 0, 7), out);
+	BOOST_CHECK_EQUAL (out, "123:00:00.007");
+
+	out.clear ();
+	sub::format_time<sub::WebVTTTimeFormat>(Time::from_hms(0, 0, -1, 0), out);
+	BOOST_CHECK_EQUAL (out, "00:00:00.000");
+
+	/* A time without a rate has frames, not milliseconds */
+	BOOST_CHECK_THROW (sub::format_time<sub::WebVTTTimeFormat>(Time::from_hmsf(0, 0, 1, 12), out), sub::UnknownFrameRateError);
+
+	/* Whatever is written can be parsed back */
+	for (int64_t ms = 0; ms < 3600 * 1000 * 3; ms += 7919) {
+		out.clear ();
+		sub::format_time<sub::SubripTimeFormat>(Time::from_ticks(ms * (Time::ticks_per_second / 1000), sub::Rational(1000, 1)), out);
+		auto const r = sub::parse_time<sub::SubripTimeFormat>(out);
+		BOOST_REQUIRE (r);
+		BOOST_CHECK_EQUAL (r.time.ticks(), ms * (Time::ticks_per_second / 1000));
+	}
+}
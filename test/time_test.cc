@@ -97,3 +97,30 @@ BOOST_AUTO_TEST_CASE (time_scale_test2)
 	BOOST_CHECK_EQUAL (t.seconds(), 1);
 	BOOST_CHECK_EQUAL (t.frames_at(sub::Rational(1000, 1)), 920);
 }
+
+/* Check that times in different rates which are the same compare equal, and that the NTSC rates are exact */
+BOOST_AUTO_TEST_CASE (time_ticks_test)
+{
+	BOOST_CHECK_EQUAL (sub::Time::from_hmsf (0, 0, 1, 12, sub::Rational(24, 1)), sub::Time::from_hms (0, 0, 1, 500));
+	BOOST_CHECK_EQUAL (sub::Time::from_hmsf (0, 0, 1, 1, sub::Rational(25, 1)), sub::Time::from_hmsf (0, 0, 1, 2, sub::Rational(50, 1)));
+	BOOST_CHECK (sub::Time::from_hmsf (0, 0, 1, 1, sub::Rational(25, 1)) < sub::Time::from_hmsf (0, 0, 1, 1, sub::Rational(24, 1)));
+
+	/* 24000 frames at 24000/1001 is exactly 1001 seconds */
+	sub::Time const ntsc = sub::Time::from_hmsf (0, 0, 0, 24000, sub::Rational(24000, 1001));
+	BOOST_CHECK_EQUAL (ntsc.ticks(), 1001 * sub::Time::ticks_per_second);
+	BOOST_CHECK_EQUAL (sub::Time::from_hmsf (0, 0, 0, 1, sub::Rational(30000, 1001)).ticks() * 30000, 1001 * sub::Time::ticks_per_second);
+
+	/* Times without a rate still compare with each other */
+	BOOST_CHECK (sub::Time::from_hmsf (0, 0, 5, 3) < sub::Time::from_hmsf (0, 0, 5, 4));
+	BOOST_CHECK (sub::Time::from_hmsf (0, 0, 5, 9) < sub::Time::from_hmsf (0, 0, 6, 0));
+	BOOST_CHECK_THROW (sub::Time::from_hmsf (0, 0, 5, 3).milliseconds(), sub::UnknownFrameRateError);
+
+	/* ...but only with times that have a rate if they are in different seconds */
+	auto const rateless = sub::Time::from_hmsf (0, 0, 1, 12);
+	BOOST_CHECK_THROW (rateless < sub::Time::from_hms (0, 0, 1, 100), sub::UnknownFrameRateError);
+	BOOST_CHECK_THROW (rateless > sub::Time::from_hms (0, 0, 1, 100), sub::UnknownFrameRateError);
+	BOOST_CHECK_THROW (rateless == sub::Time::from_hms (0, 0, 1, 100), sub::UnknownFrameRateError);
+	BOOST_CHECK (rateless < sub::Time::from_hms (0, 0, 2, 0));
+	BOOST_CHECK (rateless > sub::Time::from_hms (0, 0, 0, 999));
+	BOOST_CHECK (rateless != sub::Time::from_hms (0, 0, 3, 0));
+}
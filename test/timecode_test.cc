@@ -0,0 +1,96 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "exceptions.h"
+#include "timecode.h"
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+
+
+using std::string;
+
+
+static string
+str (sub::Timecode const& t)
+{
+	std::ostringstream s;
+	s << t;
+	return s.str();
+}
+
+
+BOOST_AUTO_TEST_CASE (timecode_drop_frame_test)
+{
+	sub::Rational const rate (30000, 1001);
+
+	BOOST_CHECK_EQUAL (str(sub::Timecode::from_frames(1799, rate, true)), "00:00:59;29");
+	BOOST_CHECK_EQUAL (str(sub::Timecode::from_frames(1800, rate, true)), "00:01:00;02");
+	BOOST_CHECK_EQUAL (str(sub::Timecode::from_frames(17982, rate, true)), "00:10:00;00");
+	BOOST_CHECK_EQUAL (str(sub::Timecode::from_frames(107892, rate, true)), "01:00:00;00");
+	BOOST_CHECK_EQUAL (str(sub::Timecode::from_frames(3600, sub::Rational(60000, 1001), true)), "00:01:00;04");
+
+	/* Every frame in a day survives a round trip */
+	for (int64_t i = 0; i < 24 * 107892; ++i) {
+		auto const t = sub::Timecode::from_frames (i, rate, true);
+		BOOST_REQUIRE_EQUAL (t.to_frames(rate), i);
+	}
+
+	/* An hour of drop-frame timecode is an hour of clock time, to within 3.6ms */
+	auto const hour = sub::Timecode(1, 0, 0, 0, true).to_time(rate);
+	BOOST_CHECK (hour.ticks() - 3600 * sub::Time::ticks_per_second < sub::Time::ticks_per_second * 36 / 10000);
+}
+
+
+BOOST_AUTO_TEST_CASE (timecode_non_drop_test)
+{
+	sub::Rational const rate (24000, 1001);
+
+	/* An hour of non-drop timecode at 24000/1001 is 3.6 seconds more than an hour */
+	auto const hour = sub::Timecode(1, 0, 0, 0).to_time(rate);
+	BOOST_CHECK_EQUAL (hour, sub::Time::from_hms(1, 0, 3, 600));
+	BOOST_CHECK (sub::Timecode::from_time(hour, rate) == sub::Timecode(1, 0, 0, 0));
+
+	/* At integer rates timecode is the same as clock time */
+	BOOST_CHECK_EQUAL (sub::Timecode(2, 3, 4, 5).to_time(sub::Rational(25, 1)), sub::Time::from_hmsf(2, 3, 4, 5, sub::Rational(25, 1)));
+}
+
+
+/** Check that a time without a rate cannot be given a timecode, as its frames are not real ticks */
+BOOST_AUTO_TEST_CASE (timecode_from_rateless_time_test)
+{
+	BOOST_CHECK_THROW (sub::Timecode::from_time(sub::Time::from_hmsf(0, 0, 1, 12), sub::Rational(25, 1)), sub::UnknownFrameRateError);
+	BOOST_CHECK (sub::Timecode::from_time(sub::Time::from_hmsf(0, 0, 1, 12, sub::Rational(25, 1)), sub::Rational(25, 1)) == sub::Timecode(0, 0, 1, 12));
+}
+
+
+/** Check that frames survive a round trip through ticks, at rates with and without a fast path */
+BOOST_AUTO_TEST_CASE (timecode_frames_to_ticks_test)
+{
+	for (auto rate: { sub::Rational(24000, 1001), sub::Rational(30000, 1001), sub::Rational(60000, 1001), sub::Rational(25, 1), sub::Rational(48, 1), sub::Rational(23, 1) }) {
+		for (int64_t i = 0; i < 10000000; i += 997) {
+			BOOST_REQUIRE_EQUAL (sub::ticks_to_frames(sub::frames_to_ticks(i, rate), rate), i);
+		}
+	}
+
+	for (int64_t i = 0; i < 100000000000; i += 99991 * 997) {
+		BOOST_REQUIRE_EQUAL (sub::ticks_to_frames(i, sub::Rational(48, 1)), (sub::FixedFrameRate<48, 1>::ticks_to_frames(i)));
+	}
+
+	BOOST_CHECK_EQUAL (sub::Time::from_frames(1001, sub::Rational(24000, 1001)).ticks(), 1001 * 1001 * sub::Time::ticks_per_second / 24000);
+}
@@ -0,0 +1,197 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "collect.h"
+#include "hls_web_vtt_reader.h"
+#include "line_source.h"
+#include "subtitle.h"
+#include "web_vtt_reader.h"
+#include "web_vtt_writer.h"
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+using std::string;
+using std::vector;
+
+
+static sub::Subtitle
+make_subtitle (sub::Time from, sub::Time to, vector<string> lines)
+{
+	sub::Subtitle subtitle;
+	subtitle.from = from;
+	subtitle.to = to;
+	for (size_t i = 0; i < lines.size(); ++i) {
+		sub::Line line;
+		line.vertical_position.line = i;
+		line.vertical_position.reference = sub::TOP_OF_SUBTITLE;
+		sub::Block block;
+		block.text = lines[i];
+		line.blocks.push_back(block);
+		subtitle.lines.push_back(line);
+	}
+	return subtitle;
+}
+
+
+static string
+read_file (boost::filesystem::path path)
+{
+	std::ifstream in(path.string().c_str());
+	return string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+
+BOOST_AUTO_TEST_CASE(web_vtt_writer_markup_test)
+{
+	auto subtitle = make_subtitle(sub::Time::from_hms(0, 0, 1, 0), sub::Time::from_hms(1, 2, 3, 45), {"Plain "});
+
+	sub::Block block;
+	block.text = "bold ";
+	block.bold = true;
+	subtitle.lines[0].blocks.push_back(block);
+	block.text = "and italic";
+	block.italic = true;
+	subtitle.lines[0].blocks.push_back(block);
+	block.text = " red <3";
+	block.bold = block.italic = false;
+	block.colour = sub::Colour(0.9, 0.1, 0);
+	subtitle.lines[0].blocks.push_back(block);
+
+	subtitle.lines[0].vertical_position.reference = sub::BOTTOM_OF_SCREEN;
+	subtitle.lines[0].vertical_position.proportional = 0.1;
+	subtitle.lines[0].horizontal_position.reference = sub::LEFT_OF_SCREEN;
+	subtitle.lines[0].horizontal_position.proportional = 0.25;
+
+	std::ostringstream out;
+	sub::write_web_vtt({subtitle}, out);
+
+	BOOST_CHECK_EQUAL(
+		out.str(),
+		"WEBVTT\n\n"
+		"00:00:01.000 --> 01:02:03.045 line:90%,end position:25% align:left\n"
+		"Plain <b>bold <i>and italic</i></b><c.red> red &lt;3</c>\n\n"
+		);
+}
+
+
+/** Check that a WebVTT file comes back the same after writing it out again */
+BOOST_AUTO_TEST_CASE(web_vtt_writer_round_trip_test)
+{
+	sub::MappedLineSource source("test/data/test.vtt");
+	sub::WebVTTReader reader(source);
+	auto const subs = sub::collect<vector<sub::Subtitle>>(reader.subtitles());
+
+	std::ostringstream out;
+	sub::write_web_vtt(subs, out);
+
+	BOOST_CHECK_EQUAL(
+		out.str(),
+		"WEBVTT\n\n"
+		"00:00:41.090 --> 00:00:42.210\n"
+		"This is a subtitle\n"
+		"and that's a line break\n\n"
+		"00:01:01.010 --> 00:01:02.100\n"
+		"This is some stuff.\n\n"
+		);
+
+	sub::WebVTTReader again(out.str());
+	BOOST_CHECK(sub::collect<vector<sub::Subtitle>>(again.subtitles()) == subs);
+}
+
+
+/** Check that cues which span segment boundaries are written to each segment
+ *  that they overlap, and that reading the segments back gives what we started with.
+ */
+BOOST_AUTO_TEST_CASE(hls_web_vtt_segmenter_test)
+{
+	boost::filesystem::path const dir = "build/test/hls_web_vtt_segmenter_test";
+	boost::filesystem::remove_all(dir);
+	boost::filesystem::create_directories(dir);
+
+	vector<sub::Subtitle> subs = {
+		make_subtitle(sub::Time::from_hms(0, 0, 1, 0), sub::Time::from_hms(0, 0, 2, 0), {"A"}),
+		make_subtitle(sub::Time::from_hms(0, 0, 4, 0), sub::Time::from_hms(0, 0, 11, 0), {"B", "spans three segments"}),
+		make_subtitle(sub::Time::from_hms(0, 0, 12, 0), sub::Time::from_hms(0, 0, 13, 0), {"C"}),
+		make_subtitle(sub::Time::from_hms(0, 0, 24, 0), sub::Time::from_hms(0, 0, 26, 0), {"D"})
+	};
+
+	sub::HLSWebVTTSegmenter segmenter(dir, "subs", 5, 900000);
+	for (auto const& i: subs) {
+		segmenter.write(i);
+	}
+	segmenter.finish();
+
+	BOOST_REQUIRE_EQUAL(segmenter.segments(), 6);
+
+	BOOST_CHECK_EQUAL(
+		read_file(dir / "subs.m3u8"),
+		"#EXTM3U\n"
+		"#EXT-X-VERSION:3\n"
+		"#EXT-X-TARGETDURATION:5\n"
+		"#EXT-X-MEDIA-SEQUENCE:0\n"
+		"#EXT-X-PLAYLIST-TYPE:VOD\n"
+		"#EXTINF:5.000,\nsubs_00000.vtt\n"
+		"#EXTINF:5.000,\nsubs_00001.vtt\n"
+		"#EXTINF:5.000,\nsubs_00002.vtt\n"
+		"#EXTINF:5.000,\nsubs_00003.vtt\n"
+		"#EXTINF:5.000,\nsubs_00004.vtt\n"
+		"#EXTINF:5.000,\nsubs_00005.vtt\n"
+		"#EXT-X-ENDLIST\n"
+		);
+
+	BOOST_CHECK_EQUAL(
+		read_file(dir / "subs_00002.vtt"),
+		"WEBVTT\n"
+		"X-TIMESTAMP-MAP=MPEGTS:900000,LOCAL:00:00:00.000\n\n"
+		"00:00:04.000 --> 00:00:11.000\n"
+		"B\n"
+		"spans three segments\n\n"
+		"00:00:12.000 --> 00:00:13.000\n"
+		"C\n\n"
+		);
+
+	/* A gap gives an empty segment */
+	BOOST_CHECK_EQUAL(read_file(dir / "subs_00003.vtt"), "WEBVTT\nX-TIMESTAMP-MAP=MPEGTS:900000,LOCAL:00:00:00.000\n\n");
+
+	/* D crosses the boundary at 25s so it is in both of the last two segments */
+	for (int i = 4; i < 6; ++i) {
+		BOOST_CHECK_EQUAL(
+			read_file(segmenter.segment_path(i)),
+			"WEBVTT\n"
+			"X-TIMESTAMP-MAP=MPEGTS:900000,LOCAL:00:00:00.000\n\n"
+			"00:00:24.000 --> 00:00:26.000\n"
+			"D\n\n"
+			);
+	}
+
+	vector<boost::filesystem::path> segments;
+	for (int i = 0; i < segmenter.segments(); ++i) {
+		segments.push_back(segmenter.segment_path(i));
+	}
+	sub::HLSWebVTTReader reader(segments, 900000);
+	/* B is repeated in two segments after its first, and D in one */
+	BOOST_CHECK_EQUAL(reader.repeated_cues(), 3);
+	BOOST_CHECK(sub::collect<vector<sub::Subtitle>>(reader.subtitles()) == subs);
+}
@@ -22,6 +22,7 @@
 #include "test.h"
 #include "exceptions.h"
 #include "collect.h"
+#include "line_source.h"
 #include <boost/test/unit_test.hpp>
 #include <boost/filesystem.hpp>
 #include <cmath>
@@ -106,3 +107,33 @@ BOOST_AUTO_TEST_CASE(vtt_reader_test)
 	BOOST_CHECK_EQUAL(b.underline, false);
 }
 
+
+
+/** Check that a cue with a bad time line can be skipped */
+BOOST_AUTO_TEST_CASE(vtt_reader_skip_cue_test)
+{
+	std::string const vtt =
+		"WEBVTT\n\n"
+		"00:00:01.000 --> 00:00:02.000\nOne\n\n"
+		"00:00:03.000 --> 00:00:0x.000\nTwo\n\n"
+		"00:00:05.000 --> 00:00:06.000\nThree\n";
+
+	{
+		sub::MemoryLineSource source(vtt.data(), vtt.size());
+		BOOST_CHECK_THROW(sub::WebVTTReader reader(source), sub::WebVTTError);
+	}
+
+	auto diagnostics = std::make_shared<sub::CollectingDiagnosticSink>();
+	sub::MemoryLineSource source(vtt.data(), vtt.size());
+	sub::WebVTTReader reader(source, diagnostics, sub::ErrorPolicy::SKIP_CUE);
+
+	auto const subs = reader.subtitles();
+	BOOST_REQUIRE_EQUAL(subs.size(), 2U);
+	BOOST_CHECK_EQUAL(subs[0].text, "One");
+	BOOST_CHECK_EQUAL(subs[1].text, "Three");
+
+	auto const reported = diagnostics->diagnostics();
+	BOOST_REQUIRE_EQUAL(reported.size(), 1U);
+	BOOST_CHECK(reported[0].code == sub::DiagnosticCode::BAD_CUE);
+	BOOST_CHECK_EQUAL(reported[0].line.get(), 6);
+}
@@ -0,0 +1,121 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  tools/collect_benchmark.cc
+ *  @brief Measure the time taken and memory allocations made by sub::collect.
+ */
+
+#include "collect.h"
+#include "raw_subtitle.h"
+#include "subtitle.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+using std::cout;
+using std::string;
+using std::vector;
+
+static std::atomic<long> allocations (0);
+
+void*
+operator new (std::size_t size)
+{
+	++allocations;
+	if (auto p = malloc(size ? size : 1)) {
+		return p;
+	}
+	throw std::bad_alloc ();
+}
+
+void
+operator delete (void* p) noexcept
+{
+	free (p);
+}
+
+void
+operator delete (void* p, std::size_t) noexcept
+{
+	free (p);
+}
+
+/** Make some fragments: each subtitle has two lines, each of which has two differently-styled fragments */
+static vector<sub::RawSubtitle>
+make_fragments (int subtitles)
+{
+	vector<sub::RawSubtitle> raw;
+	raw.reserve (subtitles * 4);
+
+	for (int i = 0; i < subtitles; ++i) {
+		for (int line = 0; line < 2; ++line) {
+			for (int block = 0; block < 2; ++block) {
+				sub::RawSubtitle r;
+				r.text = "This is some text which is too long for the small string optimisation " + std::to_string(i);
+				r.font = string("A font name which is also quite a long string");
+				r.italic = block == 1;
+				r.from = sub::Time::from_hms (0, 0, i, 0);
+				r.to = sub::Time::from_hms (0, 0, i, 500);
+				r.vertical_position.line = line;
+				r.vertical_position.reference = sub::TOP_OF_SUBTITLE;
+				raw.push_back (r);
+			}
+		}
+	}
+
+	return raw;
+}
+
+template <class F>
+static void
+measure (string name, size_t fragments, F function)
+{
+	long const before = allocations;
+	auto const start = std::chrono::steady_clock::now ();
+	auto const subs = function ();
+	auto const end = std::chrono::steady_clock::now ();
+	long const made = allocations - before;
+
+	cout << name << ": " << subs.size() << " subtitles, "
+	     << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << "ms, "
+	     << static_cast<double>(made) / fragments << " allocations per fragment\n";
+}
+
+int
+main (int argc, char* argv[])
+{
+	int const subtitles = argc > 1 ? atoi(argv[1]) : 100000;
+
+	{
+		auto raw = make_fragments (subtitles);
+		measure ("collect (copy)", raw.size(), [&raw]() { return sub::collect<vector<sub::Subtitle>>(raw); });
+	}
+
+	{
+		auto raw = make_fragments (subtitles);
+		auto const size = raw.size ();
+		measure ("collect (move)", size, [&raw]() { return sub::collect<vector<sub::Subtitle>>(std::move(raw)); });
+	}
+
+	return 0;
+}
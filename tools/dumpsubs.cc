@@ -20,36 +20,98 @@
 #include "reader_factory.h"
 #include "reader.h"
 #include "collect.h"
+#include "diff.h"
+#include "subtitle.h"
 #include "util.h"
 #include <getopt.h>
 #include <boost/filesystem.hpp>
 #include <map>
 #include <iostream>
+#include <vector>
 
 using std::string;
 using std::cerr;
 using std::cout;
 using std::map;
 using std::shared_ptr;
+using std::vector;
 using namespace sub;
 
 static void
 help (string n)
 {
-	cerr << "Syntax: " << n << " <file>\n";
+	cerr << "Syntax: " << n << " [OPTION] <file> [<file> ...]\n"
+	     << "  -j, --jobs  number of files to read at once (default 1)\n"
+	     << "  -d, --diff  show the differences between two files\n"
+	     << "  -t, --tolerant  skip cues which cannot be read, rather than giving up\n"
+	     << "  -h, --help  show this help\n";
+}
+
+static string
+text (Subtitle const& sub)
+{
+	string s;
+	for (auto const& i: sub.lines) {
+		if (!s.empty()) {
+			s += " | ";
+		}
+		for (auto const& j: i.blocks) {
+			s += j.text;
+		}
+	}
+	return s;
+}
+
+static void
+print (char prefix, Subtitle const& sub)
+{
+	cout << prefix << " " << sub.from << " --> " << sub.to << " " << text(sub) << "\n";
+}
+
+/** Print the differences between the subtitles in two readers */
+static void
+print_diff (shared_ptr<Reader> a_reader, shared_ptr<Reader> b_reader)
+{
+	auto const a = collect<vector<Subtitle>> (a_reader->subtitles());
+	auto const b = collect<vector<Subtitle>> (b_reader->subtitles());
+
+	for (auto const& i: diff(a, b)) {
+		switch (i.type) {
+		case Change::Type::INSERTED:
+			print ('+', b[*i.b]);
+			break;
+		case Change::Type::DELETED:
+			print ('-', a[*i.a]);
+			break;
+		case Change::Type::RETIMED:
+			cout << "~ " << a[*i.a].from << " --> " << a[*i.a].to << " is now " << b[*i.b].from << " --> " << b[*i.b].to << " " << text(b[*i.b]) << "\n";
+			break;
+		case Change::Type::CHANGED:
+			print ('<', a[*i.a]);
+			print ('>', b[*i.b]);
+			break;
+		}
+	}
 }
 
 int
 main (int argc, char* argv[])
 {
+	int jobs = 1;
+	bool show_diff = false;
+	auto error_policy = ErrorPolicy::THROW;
+
 	int option_index = 0;
 	while (1) {
 		static struct option long_options[] = {
 			{ "help", no_argument, 0, 'h'},
+			{ "jobs", required_argument, 0, 'j'},
+			{ "diff", no_argument, 0, 'd'},
+			{ "tolerant", no_argument, 0, 't'},
 			{ 0, 0, 0, 0 }
 		};
 
-		int c = getopt_long (argc, argv, "h", long_options, &option_index);
+		int c = getopt_long (argc, argv, "hj:dt", long_options, &option_index);
 
 		if (c == -1) {
 			break;
@@ -59,26 +121,85 @@ main (int argc, char* argv[])
 		case 'h':
 			help (argv[0]);
 			exit (EXIT_SUCCESS);
+		case 'j':
+			jobs = atoi (optarg);
+			if (jobs < 1) {
+				cerr << argv[0] << ": --jobs must be at least 1.\n";
+				exit (EXIT_FAILURE);
+			}
+			break;
+		case 'd':
+			show_diff = true;
+			break;
+		case 't':
+			error_policy = ErrorPolicy::SKIP_CUE;
+			break;
+		default:
+			help (argv[0]);
+			exit (EXIT_FAILURE);
 		}
 	}
 
-	if (argc <= optind || argc > (optind + 1)) {
+	if (argc <= optind) {
 		help (argv[0]);
 		exit (EXIT_FAILURE);
 	}
 
-	if (!boost::filesystem::exists (argv[optind])) {
-		cerr << argv[0] << ": file " << argv[optind] << " not found.\n";
-		exit (EXIT_FAILURE);
+	vector<boost::filesystem::path> files;
+	for (int i = optind; i < argc; ++i) {
+		files.push_back (argv[i]);
 	}
 
-	shared_ptr<Reader> reader = reader_factory (argv[optind]);
-	if (!reader) {
-		cerr << argv[0] << ": could not read subtitle file " << argv[optind] << "\n";
+	if (show_diff && files.size() != 2) {
+		cerr << argv[0] << ": --diff needs two files.\n";
 		exit (EXIT_FAILURE);
 	}
 
-	sub::dump (reader, cout);
+	bool ok = true;
+	bool const many = files.size() > 1 && !show_diff;
+
+	auto const results = reader_factory (files, jobs, error_policy);
+	for (auto const& i: results) {
+		if (many) {
+			cout << "== " << i.file.string() << "\n";
+		}
+
+		if (!boost::filesystem::exists (i.file)) {
+			cerr << argv[0] << ": file " << i.file.string() << " not found.\n";
+			ok = false;
+			continue;
+		}
+
+		for (auto const& j: i.diagnostics) {
+			cerr << argv[0] << ": " << i.file.string() << ": " << j << "\n";
+		}
+
+		if (i.error) {
+			try {
+				std::rethrow_exception (i.error);
+			} catch (std::exception& e) {
+				cerr << argv[0] << ": could not read subtitle file " << i.file.string() << ": " << e.what() << "\n";
+			} catch (...) {
+				cerr << argv[0] << ": could not read subtitle file " << i.file.string() << "\n";
+			}
+			ok = false;
+			continue;
+		}
+
+		if (!i.reader) {
+			cerr << argv[0] << ": could not read subtitle file " << i.file.string() << "\n";
+			ok = false;
+			continue;
+		}
+
+		if (!show_diff) {
+			sub::dump (i.reader, cout);
+		}
+	}
+
+	if (show_diff && ok) {
+		print_diff (results[0].reader, results[1].reader);
+	}
 
-	return 0;
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -0,0 +1,86 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  tools/subrip_benchmark.cc
+ *  @brief Measure how quickly SubripReader parses SubRip in memory, and write_subrip() writes it again.
+ */
+
+#include "collect.h"
+#include "scan.h"
+#include "subrip_reader.h"
+#include "subrip_writer.h"
+#include "subtitle.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using std::cout;
+using std::string;
+
+/** @return some SubRip with cues of plain text and cues with tags */
+static string
+make_subrip (int cues)
+{
+	string s;
+	for (int i = 0; i < cues; ++i) {
+		int const start = i * 2;
+		char timing[64];
+		snprintf (timing, sizeof(timing), "%02d:%02d:%02d,000 --> %02d:%02d:%02d,500\n", start / 3600, (start / 60) % 60, start % 60, start / 3600, (start / 60) % 60, start % 60);
+		if (i > 0) {
+			s += "\n";
+		}
+		s += std::to_string(i + 1) + "\n" + timing;
+		if (i % 4 == 0) {
+			s += "<i>This line is in italics</i> and <b>this is bold</b>\n<font color=\"#ff8000\">and this one is orange</font>\n";
+		} else {
+			s += "This is a fairly ordinary line of subtitle text\nwhich goes over two lines, as they often do.\n";
+		}
+	}
+	return s;
+}
+
+int
+main (int argc, char* argv[])
+{
+	int const cues = argc > 1 ? atoi(argv[1]) : 200000;
+	auto const subrip = make_subrip (cues);
+
+	auto const start = std::chrono::steady_clock::now ();
+	sub::SubripReader reader (subrip);
+	auto const end = std::chrono::steady_clock::now ();
+
+	double const seconds = std::chrono::duration<double>(end - start).count();
+	cout << subrip.size() / 1e6 << "MB, " << reader.subtitles().size() << " subtitles in " << seconds << "s: "
+	     << subrip.size() / 1e6 / seconds << "MB/s using "
+	     << sub::scan_implementation_name(sub::best_scan_implementation()) << " scanning\n";
+
+	auto const subs = sub::collect<std::vector<sub::Subtitle>>(reader.subtitles());
+	string written;
+	auto const write_start = std::chrono::steady_clock::now ();
+	sub::format_subrip (subs, written);
+	auto const write_end = std::chrono::steady_clock::now ();
+
+	double const write_seconds = std::chrono::duration<double>(write_end - write_start).count();
+	cout << "Wrote " << written.size() / 1e6 << "MB in " << write_seconds << "s: " << written.size() / 1e6 / write_seconds << "MB/s"
+	     << (written == subrip ? "" : " (output differs from input)") << "\n";
+
+	return 0;
+}
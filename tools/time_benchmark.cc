@@ -0,0 +1,102 @@
+/*
+    Copyright (C) 2026 Carl Hetherington <cth@carlh.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/** @file  tools/time_benchmark.cc
+ *  @brief Compare parse_time() with the way that the readers used to parse timestamps.
+ */
+
+#include "time_parser.h"
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using std::cout;
+using std::string;
+using std::vector;
+
+/** The SubRip parsing that parse_time() replaced */
+static boost::optional<sub::Time>
+split_and_cast (string t)
+{
+	vector<string> a;
+	boost::algorithm::split (a, t, boost::is_any_of (":"));
+	if (a.size() != 3) {
+		return {};
+	}
+
+	vector<string> b;
+	boost::algorithm::split (b, a[2], boost::is_any_of (","));
+	if (b.size() != 2) {
+		return {};
+	}
+
+	try {
+		return sub::Time::from_hms (
+			boost::lexical_cast<int>(a[0]), boost::lexical_cast<int>(a[1]), boost::lexical_cast<int>(b[0]), boost::lexical_cast<int>(b[1])
+			);
+	} catch (boost::bad_lexical_cast &) {
+		return {};
+	}
+}
+
+template <class F>
+static double
+run (vector<string> const& times, F parse)
+{
+	int64_t total = 0;
+	auto const start = std::chrono::steady_clock::now ();
+	for (auto const& i: times) {
+		total += parse(i).ticks();
+	}
+	auto const end = std::chrono::steady_clock::now ();
+
+	/* Use the result so that the work cannot be optimised away */
+	if (total == 42) {
+		cout << "";
+	}
+
+	return std::chrono::duration<double>(end - start).count();
+}
+
+int
+main (int argc, char* argv[])
+{
+	int const count = argc > 1 ? atoi(argv[1]) : 2000000;
+
+	vector<string> times;
+	times.reserve (count);
+	for (int i = 0; i < count; ++i) {
+		char buffer[64];
+		snprintf (buffer, sizeof(buffer), "%02d:%02d:%02d,%03d", (i / 3600000) % 100, (i / 60000) % 60, (i / 1000) % 60, i % 1000);
+		times.push_back (buffer);
+	}
+
+	double const before = run (times, [](string const& t) { return split_and_cast(t).get(); });
+	double const after = run (times, [](string const& t) { return sub::parse_time<sub::SubripTimeFormat>(t).time; });
+
+	cout << count << " times: split and lexical_cast " << (count / before / 1e6) << "M/s, "
+	     << "parse_time " << (count / after / 1e6) << "M/s (" << (before / after) << "x faster)\n";
+
+	return 0;
+}